@@ -0,0 +1,90 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Clock, the one time source the animation reads, real-time or a fixed step per frame
+
+// Std. Includes
+#include <thread>
+
+// custom Includes
+#include "Clock.h"
+
+
+Clock::Clock(ClockMode mode, double step) :
+	mode(mode), step(step), time(0.0), delta(0.0), frame(0), started(false)
+{
+}
+
+void Clock::Start()
+{
+	start = std::chrono::steady_clock::now();
+	time = delta = 0.0;
+	frame = 0;
+	started = true;
+}
+
+double Clock::Tick()
+{
+	// The first tick is frame zero at time zero
+	if (!started) {
+		Start();
+		return time;
+	}
+	frame++;
+
+	double previous = time;
+	switch (mode) {
+	case REALTIME_CLOCK:
+		time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		break;
+	case FIXED_STEP_CLOCK:
+		// Early frames wait for their slot, late ones don't try to catch up
+		time = frame * step;
+		std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(time)));
+		break;
+	case UNLIMITED_CLOCK:
+	case REPLAY_CLOCK:
+		time = frame * step;
+		break;
+	}
+	delta = time - previous;
+	return time;
+}
+
+double Clock::TickTo(double recorded)
+{
+	if (!started)
+		Start();
+	else
+		frame++;
+
+	delta = recorded - time;
+	time = recorded;
+	return time;
+}
+
+bool Clock::ParseMode(const std::string& name, ClockMode& mode)
+{
+	if (name == "realtime")
+		mode = REALTIME_CLOCK;
+	else if (name == "fixed")
+		mode = FIXED_STEP_CLOCK;
+	else if (name == "fast")
+		mode = UNLIMITED_CLOCK;
+	else
+		return false;
+	return true;
+}
+
+const char* Clock::ModeName(ClockMode mode)
+{
+	switch (mode) {
+	case FIXED_STEP_CLOCK:
+		return "fixed";
+	case UNLIMITED_CLOCK:
+		return "fast";
+	case REPLAY_CLOCK:
+		return "replay";
+	default:
+		return "realtime";
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Clock, the one time source the animation reads, real-time or a fixed step per frame
+
+// Std. Includes
+#include <chrono>
+#include <string>
+
+// How animation time advances from one frame to the next
+enum ClockMode {
+	REALTIME_CLOCK,      // Wall time since Start, frames land wherever the machine puts them
+	FIXED_STEP_CLOCK,    // Exactly one step per frame, paced to wall time
+	UNLIMITED_CLOCK,     // Exactly one step per frame, as fast as the machine can draw them
+	REPLAY_CLOCK         // Frame times read back from a recorded session with TickTo
+};
+
+class Clock
+{
+public:
+	// Constructor, step is the seconds per frame of the fixed modes
+	Clock(ClockMode mode = REALTIME_CLOCK, double step = 1.0 / 60.0);
+
+	// Time zero is now
+	void Start();
+
+	// Advance to the next frame and return its time in seconds, waits when pacing the fixed step
+	double Tick();
+
+	// Advance to the next frame at a given time, for replaying recorded frame times
+	double TickTo(double time);
+
+	// Time of the current frame, and how far it moved since the previous one
+	double Time() const { return time; }
+	double Delta() const { return delta; }
+
+	// Frames ticked since Start
+	long long Frame() const { return frame; }
+
+	ClockMode Mode() const { return mode; }
+	double Step() const { return step; }
+
+	// Every frame time is known in advance, so every run draws the same frames
+	bool Deterministic() const { return mode != REALTIME_CLOCK; }
+
+	// "realtime", "fixed" or "fast", false for anything else. Replay is chosen by --replay instead
+	static bool ParseMode(const std::string& name, ClockMode& mode);
+	static const char* ModeName(ClockMode mode);
+
+private:
+	/*  Clock data  */
+	ClockMode mode;
+	double step;
+	std::chrono::steady_clock::time_point start;
+	double time;
+	double delta;
+	long long frame;
+	bool started;
+};
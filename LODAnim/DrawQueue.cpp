@@ -0,0 +1,96 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Draw Queue, a frame's draws under 64-bit sort keys, radix sorted so draws sharing state run together
+
+// Std. Includes
+#include <cstring>
+#include <algorithm>
+
+// custom Includes
+#include "DrawQueue.h"
+
+static const int PASS_SHIFT = 58, PROGRAM_SHIFT = 48, MESH_SHIFT = 24;
+static const uint64_t PASS_MASK = 0x3F, PROGRAM_MASK = 0x3FF, MESH_MASK = 0xFFFFFF, DEPTH_MASK = 0xFFFFFF;
+
+// Times a field of the key changes from one draw to the next
+static uint64_t switches(const std::vector<DrawKey>& keys, int shift, uint64_t mask)
+{
+	uint64_t count = 0;
+	for (size_t i = 1; i < keys.size(); i++) {
+		if (((keys[i].key >> shift) & mask) != ((keys[i - 1].key >> shift) & mask))
+			count++;
+	}
+	return count;
+}
+
+
+DrawQueue::DrawQueue()
+{
+	std::memset(&stats, 0, sizeof(DrawQueueStats));
+}
+
+uint64_t DrawQueue::Key(unsigned pass, unsigned program, unsigned mesh, float distance)
+{
+	// Bits of a positive float order the same way as its value, the top 24 keep about 1% precision
+	uint32_t bits;
+	distance = std::max(distance, 0.0f);
+	std::memcpy(&bits, &distance, sizeof(float));
+
+	return ((pass & PASS_MASK) << PASS_SHIFT) | ((program & PROGRAM_MASK) << PROGRAM_SHIFT)
+		| ((mesh & MESH_MASK) << MESH_SHIFT) | ((bits >> 8) & DEPTH_MASK);
+}
+
+void DrawQueue::Count()
+{
+	stats.draws = keys.size();
+	stats.programSwitchesSubmitted = stats.programSwitchesSorted = switches(keys, PROGRAM_SHIFT, PROGRAM_MASK);
+	stats.meshSwitchesSubmitted = stats.meshSwitchesSorted = switches(keys, MESH_SHIFT, MESH_MASK);
+}
+
+void DrawQueue::Sort()
+{
+	Count();
+	RadixSort(keys, scratch);
+	stats.programSwitchesSorted = switches(keys, PROGRAM_SHIFT, PROGRAM_MASK);
+	stats.meshSwitchesSorted = switches(keys, MESH_SHIFT, MESH_MASK);
+}
+
+void DrawQueue::RadixSort(std::vector<DrawKey>& keys, std::vector<DrawKey>& scratch)
+{
+	const size_t n = keys.size();
+	if (n < 2)
+		return;
+	scratch.resize(n);
+
+	// Every byte's histogram in one read of the keys
+	uint32_t counts[8][256];
+	std::memset(counts, 0, sizeof(counts));
+	for (size_t i = 0; i < n; i++) {
+		const uint64_t key = keys[i].key;
+		for (int b = 0; b < 8; b++)
+			counts[b][(key >> (b * 8)) & 0xFF]++;
+	}
+
+	DrawKey* from = &keys[0];
+	DrawKey* to = &scratch[0];
+	for (int b = 0; b < 8; b++) {
+		// All keys share this byte, the pass would only copy
+		uint32_t* count = counts[b];
+		if (count[(from[0].key >> (b * 8)) & 0xFF] == n)
+			continue;
+
+		uint32_t offset = 0;
+		for (int d = 0; d < 256; d++) {
+			const uint32_t c = count[d];
+			count[d] = offset;
+			offset += c;
+		}
+		for (size_t i = 0; i < n; i++)
+			to[count[(from[i].key >> (b * 8)) & 0xFF]++] = from[i];
+		std::swap(from, to);
+	}
+
+	// An odd number of passes leaves the result in scratch
+	if (from != &keys[0])
+		keys.swap(scratch);
+}
@@ -0,0 +1,64 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Draw Queue, a frame's draws under 64-bit sort keys, radix sorted so draws sharing state run together
+
+// Std. Includes
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// One queued draw, item is the caller's index of what to draw
+struct DrawKey {
+	uint64_t key;
+	uint32_t item;
+};
+
+// State switches of one frame's draws, in the order they were submitted and in key order
+struct DrawQueueStats {
+	uint64_t draws;
+	uint64_t programSwitchesSubmitted;
+	uint64_t programSwitchesSorted;
+	uint64_t meshSwitchesSubmitted;
+	uint64_t meshSwitchesSorted;
+};
+
+// Key layout, most significant first:
+//   pass     6 bits   order the pass was first begun in this frame, passes never interleave
+//   program 10 bits   GL program name
+//   mesh    24 bits   where the mesh starts in the geometry arena, every mesh shares the arena's vertex array
+//   depth   24 bits   view distance of the first object, near first
+class DrawQueue
+{
+public:
+	DrawQueue();
+
+	// Sort key of a draw, distance is from the camera in view space
+	static uint64_t Key(unsigned pass, unsigned program, unsigned mesh, float distance);
+
+	void Push(uint64_t key, uint32_t item) { DrawKey draw = { key, item }; keys.push_back(draw); }
+
+	// Stable LSD radix sort of the keys, 8 bits a pass, passes where every key has the same byte are skipped.
+	// Switch counts are taken either side of it
+	void Sort();
+
+	// Count switches without sorting, for runs that keep the submission order
+	void Count();
+
+	// Draws in key order once sorted
+	const std::vector<DrawKey>& Keys() const { return keys; }
+	const DrawQueueStats& Stats() const { return stats; }
+	size_t Size() const { return keys.size(); }
+
+	// Empty for the next frame, keeps the storage
+	void Clear() { keys.clear(); }
+
+	// Sort keys with the scratch array, exposed for the benchmark
+	static void RadixSort(std::vector<DrawKey>& keys, std::vector<DrawKey>& scratch);
+
+private:
+	/*  Queue data  */
+	std::vector<DrawKey> keys;
+	std::vector<DrawKey> scratch;
+	DrawQueueStats stats;
+};
@@ -0,0 +1,148 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Frame Capture, frames read back through a ring of pixel buffer objects and written out on worker threads
+
+// Std. Includes
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+
+// custom Includes
+#include "FrameCapture.h"
+#include "ImageWriter.h"
+#include "Profiler.h"
+
+
+FrameCapture::FrameCapture(int width, int height, const std::string& directory, CaptureFormat format, unsigned encoders) :
+	width(width), height(height), directory(directory), format(format), next(0), frames(0), captureNs(0), stalls(0),
+	failures(0), encoders(encoders, "Capture")
+{
+	// Read back into buffers the driver keeps in host memory, sized for a whole frame
+	for (Slot& slot : slots) {
+		glGenBuffers(1, &slot.PBO);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.PBO);
+		glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)width * height * 4, NULL, GL_STREAM_READ);
+		slot.fence = 0;
+		slot.state = SLOT_FREE;
+		slot.frame = 0;
+		slot.encoding = false;
+		slot.pixels = NULL;
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	std::cout << "FRAME CAPTURE: " << SLOTS << " readback buffers, " << this->encoders.Workers() << " " << FormatName(format)
+		<< " encoders, to " << directory << std::endl;
+}
+
+FrameCapture::~FrameCapture()
+{
+	Finish();
+	for (Slot& slot : slots)
+		glDeleteBuffers(1, &slot.PBO);
+}
+
+void FrameCapture::Capture()
+{
+	const uint64_t start = Profiler::Now();
+	PROFILE_ZONE("Frame Capture");
+
+	// Hand every readback the GPU has finished to an encoder, oldest first
+	for (int i = 0; i < SLOTS; i++) {
+		Slot& slot = slots[(next + i) % SLOTS];
+		if (slot.state == SLOT_READING && !map(slot, false))
+			break;
+	}
+
+	// The oldest slot is reused, only waits if the ring is full of frames still being read or written
+	Slot& slot = slots[next];
+	if (slot.state == SLOT_READING) {
+		stalls++;
+		map(slot, true);
+	}
+	if (slot.state == SLOT_MAPPED) {
+		if (slot.encoding)
+			stalls++;
+		release(slot);
+	}
+
+	// Queue the readback, the GPU copies into the buffer once the frame's draws are done
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.PBO);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	slot.state = SLOT_READING;
+	slot.frame = frames++;
+	next = (next + 1) % SLOTS;
+
+	captureNs += Profiler::Now() - start;
+}
+
+void FrameCapture::Finish()
+{
+	for (int i = 0; i < SLOTS; i++) {
+		Slot& slot = slots[(next + i) % SLOTS];
+		if (slot.state == SLOT_READING)
+			map(slot, true);
+	}
+	encoders.Wait();
+	for (Slot& slot : slots) {
+		if (slot.state == SLOT_MAPPED)
+			release(slot);
+	}
+}
+
+bool FrameCapture::map(Slot& slot, bool block)
+{
+	if (glClientWaitSync(slot.fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+		if (!block)
+			return false;
+		while (glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED);
+	}
+	glDeleteSync(slot.fence);
+	slot.fence = 0;
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.PBO);
+	slot.pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)width * height * 4, GL_MAP_READ_BIT);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	if (!slot.pixels) {
+		std::cout << "ERROR::FRAME CAPTURE:: Could not map frame " << slot.frame << std::endl;
+		failures++;
+		slot.state = SLOT_FREE;
+		return true;
+	}
+	slot.state = SLOT_MAPPED;
+
+	// Encoded straight from the mapped buffer, the render thread never copies the pixels
+	slot.encoding = true;
+	Slot* encoded = &slot;
+	const std::string file = path(slot.frame);
+	encoders.Submit([this, encoded, file]() {
+		const unsigned char* rgba = static_cast<const unsigned char*>(encoded->pixels);
+		const bool written = format == CAPTURE_PNG ? WritePNG(file, rgba, width, height, true) : WritePPM(file, rgba, width, height, true);
+		if (!written)
+			failures++;
+		encoded->encoding = false;
+	});
+	return true;
+}
+
+void FrameCapture::release(Slot& slot)
+{
+	while (slot.encoding)
+		std::this_thread::yield();
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.PBO);
+	glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	slot.pixels = NULL;
+	slot.state = SLOT_FREE;
+}
+
+std::string FrameCapture::path(uint64_t frame) const
+{
+	std::ostringstream name;
+	name << directory << "/frame_" << std::setw(5) << std::setfill('0') << frame << (format == CAPTURE_PNG ? ".png" : ".ppm");
+	return name.str();
+}
@@ -0,0 +1,82 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Frame Capture, frames read back through a ring of pixel buffer objects and written out on worker threads
+
+// Std. Includes
+#include <string>
+#include <atomic>
+#include <cstdint>
+
+// GL Includes
+#include <GL/glew.h>
+
+// custom Includes
+#include "ThreadPool.h"
+
+// File format of captured frames
+enum CaptureFormat {
+	CAPTURE_PNG,
+	CAPTURE_RAW    // Binary PPM
+};
+
+// The render thread only starts a readback and maps buffers the GPU has finished with. A mapped buffer goes
+// straight to an encoder, and is unmapped when its slot comes round again. Only if every slot is still in
+// flight does the render thread wait
+class FrameCapture
+{
+public:
+	// Constructor, frames go to directory (which must exist) as frame_00000.png and on. Needs a current GL context
+	FrameCapture(int width, int height, const std::string& directory, CaptureFormat format, unsigned encoders = 0);
+	~FrameCapture();
+
+	// Start reading the framebuffer back as the next frame
+	void Capture();
+
+	// Write every frame still in flight, e.g. before exiting
+	void Finish();
+
+	/*  Render thread cost  */
+	uint64_t Frames() const { return frames; }
+	double AverageMs() const { return frames ? captureNs / 1e6 / frames : 0.0; }
+	uint64_t Stalls() const { return stalls; }        // Captures that had to wait for a readback or an encoder
+	uint64_t Failures() const { return failures; }    // Frames that couldn't be written
+
+	static const char* FormatName(CaptureFormat format) { return format == CAPTURE_PNG ? "png" : "raw"; }
+
+private:
+	static const int SLOTS = 4;
+
+	enum SlotState {
+		SLOT_FREE,
+		SLOT_READING,     // Readback queued, fenced
+		SLOT_MAPPED       // Handed to an encoder, unmapped once it's done
+	};
+
+	struct Slot {
+		GLuint PBO;
+		GLsync fence;
+		SlotState state;
+		uint64_t frame;
+		std::atomic<bool> encoding;
+		void* pixels;
+	};
+
+	// Map a finished readback and queue its encode, wait for the GPU if block
+	bool map(Slot& slot, bool block);
+	// Unmap a slot once its encode is done, waiting for the encoder if needed
+	void release(Slot& slot);
+	std::string path(uint64_t frame) const;
+
+	/*  Capture data  */
+	int width, height;
+	std::string directory;
+	CaptureFormat format;
+	Slot slots[SLOTS];
+	int next;              // Slot the next capture reads into, the oldest in flight
+	uint64_t frames;
+	uint64_t captureNs;
+	uint64_t stalls;
+	std::atomic<uint64_t> failures;
+	ThreadPool encoders;
+};
@@ -0,0 +1,91 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Frame Stats, geometry and state counters collected by the draw path every frame
+
+// Std. Includes
+#include <fstream>
+#include <iostream>
+#include <cstring>
+
+// custom Includes
+#include "FrameStats.h"
+
+
+FrameStats::FrameStats() :
+	next(0)
+{
+	std::memset(&current, 0, sizeof(FrameCounters));
+	std::memset(&last, 0, sizeof(FrameCounters));
+}
+
+FrameStats& FrameStats::Shared()
+{
+	static FrameStats stats;
+	return stats;
+}
+
+void FrameStats::Draw(GLsizei indexCount, GLsizei vertexCount, GLsizei instances, int level)
+{
+	DrawCounters draw;
+	draw.drawCalls = 1;
+	draw.instances = instances;
+	draw.triangles = (uint64_t)(indexCount / 3) * instances;
+	draw.vertices = (uint64_t)vertexCount * instances;
+
+	DrawCounters* targets[] = { &current.total, level >= 0 && level < STATS_LEVELS ? &current.levels[level] : nullptr };
+	for (DrawCounters* target : targets) {
+		if (!target)
+			continue;
+		target->drawCalls += draw.drawCalls;
+		target->instances += draw.instances;
+		target->triangles += draw.triangles;
+		target->vertices += draw.vertices;
+	}
+}
+
+void FrameStats::EndFrame(double time)
+{
+	current.time = time;
+	last = current;
+
+	// Ring of the most recent frames
+	if (series.size() < MAX_FRAMES)
+		series.push_back(current);
+	else
+		series[next] = current;
+	next = (next + 1) % MAX_FRAMES;
+
+	std::memset(&current, 0, sizeof(FrameCounters));
+}
+
+void FrameStats::Discard()
+{
+	std::memset(&current, 0, sizeof(FrameCounters));
+}
+
+bool FrameStats::WriteSeries(const std::string& path) const
+{
+	std::ofstream file(path.c_str(), std::ios::trunc);
+	if (!file) {
+		std::cout << "ERROR::FRAME STATS:: Could not write " << path << std::endl;
+		return false;
+	}
+
+	file << "time,draw_calls,instances,triangles,vertices";
+	for (int l = 0; l < STATS_LEVELS; l++)
+		file << ",l" << l << "_draw_calls,l" << l << "_triangles,l" << l << "_vertices";
+	file << ",program_binds,vertex_array_binds,buffer_binds,texture_binds,state_changes,upload_bytes,elided_calls\n";
+
+	// Oldest first, the ring starts at next once it has wrapped
+	const size_t start = series.size() < MAX_FRAMES ? 0 : next;
+	for (size_t i = 0; i < series.size(); i++) {
+		const FrameCounters& f = series[(start + i) % series.size()];
+		file << f.time << "," << f.total.drawCalls << "," << f.total.instances << "," << f.total.triangles << "," << f.total.vertices;
+		for (int l = 0; l < STATS_LEVELS; l++)
+			file << "," << f.levels[l].drawCalls << "," << f.levels[l].triangles << "," << f.levels[l].vertices;
+		file << "," << f.programBinds << "," << f.vertexArrayBinds << "," << f.bufferBinds << "," << f.textureBinds
+			<< "," << f.StateChanges() << "," << f.uploadBytes << "," << f.elidedCalls << "\n";
+	}
+	std::cout << "Frame Stats: " << series.size() << " frames written to " << path << std::endl;
+	return true;
+}
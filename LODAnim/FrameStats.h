@@ -0,0 +1,82 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Frame Stats, geometry and state counters collected by the draw path every frame
+
+// Std. Includes
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// GL Includes
+#include <GL/glew.h>
+
+// LOD levels counted separately, the impostor is level 5. Anything else (orbit rings, sun, text) is counted as unlevelled
+const int STATS_LEVELS = 6;
+
+// What the draws of one frame cost, or one LOD level's share of it
+struct DrawCounters {
+	uint64_t drawCalls;
+	uint64_t instances;
+	uint64_t triangles;
+	uint64_t vertices;
+};
+
+// One frame's counters
+struct FrameCounters {
+	double time;                        // Animation time the frame was drawn at
+	DrawCounters total;
+	DrawCounters levels[STATS_LEVELS];
+	uint64_t programBinds;
+	uint64_t vertexArrayBinds;
+	uint64_t bufferBinds;
+	uint64_t textureBinds;
+	uint64_t uploadBytes;               // Uniform ring writes and vertex buffer updates
+	uint64_t elidedCalls;               // Binds, program switches and enables skipped as redundant by the GL dispatch
+
+	uint64_t StateChanges() const { return programBinds + vertexArrayBinds + bufferBinds + textureBinds; }
+};
+
+class FrameStats
+{
+public:
+	FrameStats();
+
+	// Called by the draw path: one draw of count instances, level -1 when it isn't an LOD body
+	void Draw(GLsizei indexCount, GLsizei vertexCount, GLsizei instances, int level);
+
+	// Called wherever GL state is changed or data is uploaded, or a change is skipped
+	void ProgramBind() { current.programBinds++; }
+	void VertexArrayBind() { current.vertexArrayBinds++; }
+	void BufferBind() { current.bufferBinds++; }
+	void TextureBind() { current.textureBinds++; }
+	void Upload(size_t bytes) { current.uploadBytes += bytes; }
+	void ElidedCall() { current.elidedCalls++; }
+
+	// Close the frame drawn at time, its counters become Last() and join the time series
+	void EndFrame(double time);
+
+	// Forget what has been counted since the last EndFrame, for load-time draws that aren't part of a frame
+	void Discard();
+
+	// Counters of the last finished frame, what the HUD shows
+	const FrameCounters& Last() const { return last; }
+
+	// Counters of the frame so far
+	const FrameCounters& Current() const { return current; }
+
+	// Time series as CSV, one row per frame
+	bool WriteSeries(const std::string& path) const;
+
+	// Single collector for the window's context
+	static FrameStats& Shared();
+
+private:
+	static const size_t MAX_FRAMES = 1 << 16;  // Series length, older frames are dropped
+
+	/*  Stats data  */
+	FrameCounters current;
+	FrameCounters last;
+	std::vector<FrameCounters> series;
+	size_t next;
+};
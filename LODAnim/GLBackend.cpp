@@ -0,0 +1,199 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: GL Backend, draws through the uber shader programs, the uniform ring and the geometry arena
+
+// Std. Includes
+#include <algorithm>
+#include <cstring>
+
+// custom Includes
+#include "GLBackend.h"
+#include "GpuProfiler.h"
+#include "GLDispatch.h"
+#include "Profiler.h"
+#include "NormalMatrix.h"
+
+
+GLBackend::GLBackend(ShaderVariants& variants, int width, int height) :
+	variants(variants), width(width), height(height), currentPass(-1), sortDraws(true)
+{
+	std::memset(&totals, 0, sizeof(DrawQueueStats));
+}
+
+void GLBackend::BeginFrame(const FrameUniforms& frame, glm::vec4 clearColour)
+{
+	// Claim this frame's slice of the uniform ring, and start recording the frame
+	GLDispatch& gl = GLDispatch::Shared();
+	gl.BeginFrame();
+
+	// Clear the colorbuffer
+	gl.ClearColor(clearColour.x, clearColour.y, clearColour.z, clearColour.w);
+	gl.Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	// FrameBlock goes up with the objects' blocks at EndFrame. Depth keys are view distances
+	this->frame = frame;
+	view = frame.view;
+	queue.Clear();
+	draws.clear();
+	objects.clear();
+	passes.clear();
+	currentPass = -1;
+}
+
+void GLBackend::BeginPass(const char* pass)
+{
+	// A pass begun again carries on where it left off, its draws still sort together
+	std::vector<const char*>::iterator found = std::find(passes.begin(), passes.end(), pass);
+	currentPass = (int)(found - passes.begin());
+	if (found == passes.end())
+		passes.push_back(pass);
+}
+
+void GLBackend::EndPass()
+{
+	currentPass = -1;
+}
+
+void GLBackend::Draw(const Mesh& mesh, unsigned variant, ObjectUniforms* objects, size_t count, int level)
+{
+	PROFILE_ZONE("Draw Submission");
+	if (count == 0)
+		return;
+
+	// Draws outside a pass go between the passes either side of them, untimed
+	if (currentPass < 0) {
+		passes.push_back(nullptr);
+		currentPass = (int)passes.size() - 1;
+	}
+
+	QueuedDraw draw = { &mesh, variant, this->objects.size(), count, level, currentPass, 0 };
+	this->objects.insert(this->objects.end(), objects, objects + count);
+
+	// Program the variant will bind, the fallback one while it still compiles
+	const glm::vec4 position = view * objects[0].model[3];
+	queue.Push(DrawQueue::Key(currentPass, variants.Get(variant).Program, mesh.FirstIndex(), -position.z), (uint32_t)draws.size());
+	draws.push_back(draw);
+}
+
+void GLBackend::EndFrame()
+{
+	{
+		PROFILE_ZONE("Draw Sort");
+		if (sortDraws)
+			queue.Sort();
+		else
+			queue.Count();
+	}
+
+	const DrawQueueStats& stats = queue.Stats();
+	totals.draws += stats.draws;
+	totals.programSwitchesSubmitted += stats.programSwitchesSubmitted;
+	totals.programSwitchesSorted += stats.programSwitchesSorted;
+	totals.meshSwitchesSubmitted += stats.meshSwitchesSubmitted;
+	totals.meshSwitchesSorted += stats.meshSwitchesSorted;
+
+	// Normal matrices of every object whose program reads one, in one vectorised pass, single draws alone would
+	// never fill a batch. Rigid bodies are the bulk of the objects and skip it
+	{
+		PROFILE_ZONE("Normal Matrices");
+		normalObjects.clear();
+		normalModels.clear();
+		for (const QueuedDraw& draw : draws) {
+			if (!UsesNormalMatrix(draw.variant))
+				continue;
+			for (size_t i = draw.first; i < draw.first + draw.count; i++) {
+				normalObjects.push_back(i);
+				normalModels.push_back(objects[i].model);
+			}
+		}
+		if (!normalObjects.empty()) {
+			normalMatrices.resize(normalObjects.size());
+			ComputeNormalMatrices(&normalModels[0], &normalMatrices[0], normalModels.size());
+			for (size_t i = 0; i < normalObjects.size(); i++)
+				objects[normalObjects[i]].normalMatrix = normalMatrices[i];
+		}
+	}
+
+	// Every block the frame binds goes up in one upload before the first draw. FrameBlock is shared by every lit
+	// and lamp draw
+	{
+		PROFILE_ZONE("Uniform Upload");
+		GLDispatch& gl = GLDispatch::Shared();
+		const size_t frameBlock = gl.StageBlock(&frame, sizeof(FrameUniforms));
+		for (const DrawKey& key : queue.Keys())
+			stage(draws[key.item]);
+		gl.FlushBlocks();
+		gl.BindBlock(FRAME_BLOCK_BINDING, frameBlock);
+	}
+
+	// Keys keep passes contiguous, a pass is timed from its first draw to its last
+	{
+		PROFILE_ZONE("Draw Queue");
+		int timed = -1;
+		for (const DrawKey& key : queue.Keys()) {
+			const QueuedDraw& draw = draws[key.item];
+			if (draw.pass != timed) {
+				if (timed >= 0 && passes[timed])
+					GpuProfiler::Shared().End();
+				if (passes[draw.pass])
+					GpuProfiler::Shared().Begin(passes[draw.pass]);
+				timed = draw.pass;
+			}
+			execute(draw);
+		}
+		if (timed >= 0 && passes[timed])
+			GpuProfiler::Shared().End();
+	}
+
+	// Fence the uniform ring slice before handing the frame over
+	GLDispatch::Shared().EndUniforms();
+}
+
+void GLBackend::ReadPixels(std::vector<unsigned char>& rgba)
+{
+	rgba.resize((size_t)width * height * 4);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, &rgba[0]);
+}
+
+void GLBackend::stage(QueuedDraw& draw)
+{
+	GLDispatch& gl = GLDispatch::Shared();
+	ObjectUniforms* objects = &this->objects[draw.first];
+
+	// One block per copy of a plain draw, one per MAX_INSTANCES batch of an instanced one
+	if (!(draw.variant & VARIANT_INSTANCED)) {
+		draw.block = gl.StageBlock(&objects[0], sizeof(ObjectUniforms));
+		for (size_t i = 1; i < draw.count; i++)
+			gl.StageBlock(&objects[i], sizeof(ObjectUniforms));
+		return;
+	}
+	for (size_t first = 0; first < draw.count; first += MAX_INSTANCES) {
+		const size_t batch = std::min(draw.count - first, (size_t)MAX_INSTANCES);
+		const size_t block = gl.StageBlock(&objects[first], batch * sizeof(ObjectUniforms));
+		if (first == 0)
+			draw.block = block;
+	}
+}
+
+void GLBackend::execute(const QueuedDraw& draw)
+{
+	variants.Get(draw.variant).Use();
+
+	// One draw per copy, each with its own slice of the uniform ring
+	if (!(draw.variant & VARIANT_INSTANCED)) {
+		for (size_t i = 0; i < draw.count; i++) {
+			GLDispatch::Shared().BindBlock(OBJECT_BLOCK_BINDING, draw.block + i);
+			draw.mesh->Draw(draw.level);
+		}
+		return;
+	}
+
+	// A single draw call per MAX_INSTANCES, the shader picks its object with gl_InstanceID
+	size_t block = draw.block;
+	for (size_t first = 0; first < draw.count; first += MAX_INSTANCES) {
+		GLsizei batch = (GLsizei)std::min(draw.count - first, (size_t)MAX_INSTANCES);
+		GLDispatch::Shared().BindBlock(OBJECT_BLOCK_BINDING, block++);
+		draw.mesh->DrawInstanced(batch, draw.level);
+	}
+}
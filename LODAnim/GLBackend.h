@@ -0,0 +1,77 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: GL Backend, draws through the uber shader programs, the uniform ring and the geometry arena
+
+// Std. Includes
+#include <vector>
+
+// custom Includes
+#include "RenderBackend.h"
+#include "ShaderVariants.h"
+#include "DrawQueue.h"
+
+class GLBackend : public RenderBackend
+{
+public:
+	// Constructor, programs come from variants. Needs a current GL context
+	GLBackend(ShaderVariants& variants, int width, int height);
+
+	const char* Name() const { return "gl"; }
+
+	void BeginFrame(const FrameUniforms& frame, glm::vec4 clearColour);
+
+	// Passes are timed on the GPU. A pass only tags the draws queued in it, they run at EndFrame
+	void BeginPass(const char* pass);
+	void EndPass();
+
+	// Queued with a sort key, objects are copied. Their normal matrices are filled together at EndFrame
+	void Draw(const Mesh& mesh, unsigned variant, ObjectUniforms* objects, size_t count, int level = -1);
+
+	// Sorts and runs the queued draws, then fences this frame's uniform ring slice
+	void EndFrame();
+
+	void ReadPixels(std::vector<unsigned char>& rgba);
+
+	// Run draws in key order, or in the order they were submitted to compare against
+	void SortDraws(bool sort) { sortDraws = sort; }
+
+	// Switches of the last frame's draws, and summed over every frame
+	const DrawQueueStats& QueueStats() const { return queue.Stats(); }
+	const DrawQueueStats& QueueTotals() const { return totals; }
+
+private:
+	// A queued draw, objects are a range of the frame's copies
+	struct QueuedDraw {
+		const Mesh* mesh;
+		unsigned variant;
+		size_t first, count;
+		int level;
+		int pass;      // Index into passes
+		size_t block;  // First of its staged uniform blocks, one per copy or per instanced batch
+	};
+
+	// Stage the uniform blocks of one queued draw, in the order execute binds them
+	void stage(QueuedDraw& draw);
+
+	// Run one queued draw
+	void execute(const QueuedDraw& draw);
+
+	/*  Backend data  */
+	ShaderVariants& variants;
+	int width, height;
+	FrameUniforms frame;
+	glm::mat4 view;
+
+	/*  Queue data  */
+	DrawQueue queue;
+	std::vector<QueuedDraw> draws;
+	std::vector<ObjectUniforms> objects;
+	std::vector<size_t> normalObjects;        // Objects whose program reads their normal matrix, this frame
+	std::vector<glm::mat4> normalModels;      // Their models and normal matrices, kept between frames
+	std::vector<NormalMatrix> normalMatrices;
+	std::vector<const char*> passes;    // This frame's passes in the order they were begun, a key's pass indexes it
+	int currentPass;
+	bool sortDraws;
+	DrawQueueStats totals;
+};
@@ -0,0 +1,523 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: GL Dispatch, the GL calls the draw path makes each frame, executed, recorded to a command stream or both
+
+// Std. Includes
+#include <iostream>
+#include <cstring>
+
+// custom Includes
+#include "GLDispatch.h"
+#include "UniformRing.h"
+#include "FrameStats.h"
+
+static const char DISPATCH_MAGIC[4] = { 'L', 'O', 'D', 'G' };
+static const uint32_t DISPATCH_VERSION = 2;    // Version 1 streams have no staged blocks and still replay
+
+// Words a payload of size bytes takes, padded up
+static size_t payloadWords(size_t size)
+{
+	return (size + 3) / 4;
+}
+
+static float getFloat(uint32_t word)
+{
+	float value;
+	std::memcpy(&value, &word, sizeof(float));
+	return value;
+}
+
+
+GLDispatch::GLDispatch() :
+	mode(DISPATCH_DIRECT), frameCommands(0), frames(0), stagedBlocks(0), started(false)
+{
+	last.commands = last.bytes = 0;
+	total = last;
+	Invalidate();
+}
+
+bool GLDispatch::RecordTo(const std::string& path)
+{
+	file.open(path.c_str(), std::ios::binary | std::ios::trunc);
+	if (!file) {
+		std::cout << "ERROR::GL DISPATCH:: Could not write " << path << std::endl;
+		return false;
+	}
+	file.write(DISPATCH_MAGIC, sizeof(DISPATCH_MAGIC));
+	file.write(reinterpret_cast<const char*>(&DISPATCH_VERSION), sizeof(DISPATCH_VERSION));
+	return true;
+}
+
+void GLDispatch::BeginFrame()
+{
+	if (started)
+		closeFrame();
+	started = true;
+	stagedBlocks = 0;
+	Invalidate();
+	if (Executes())
+		UniformRing::Shared().BeginFrame();
+}
+
+void GLDispatch::EndUniforms()
+{
+	if (Executes())
+		UniformRing::Shared().EndFrame();
+	if (recording())
+		begin(OP_END_UNIFORMS, 0);
+}
+
+void GLDispatch::Finish()
+{
+	if (started)
+		closeFrame();
+	started = false;
+	if (file.is_open())
+		file.flush();
+}
+
+void GLDispatch::Discard()
+{
+	commands.clear();
+	frameCommands = 0;
+	started = false;
+}
+
+void GLDispatch::Invalidate()
+{
+	program = vertexArray = arrayBuffer = activeUnit = UNKNOWN;
+	for (int i = 0; i < TEXTURE_UNITS; i++)
+		textures[i] = UNKNOWN;
+	for (int i = 0; i < CAPABILITIES; i++)
+		enabled[i] = UNKNOWN;
+}
+
+void GLDispatch::UseProgram(GLuint program)
+{
+	if (elide(this->program, program))
+		return;
+	FrameStats::Shared().ProgramBind();
+	if (Executes())
+		glUseProgram(program);
+	if (recording()) {
+		begin(OP_USE_PROGRAM, 1);
+		put(program);
+	}
+}
+
+void GLDispatch::BindVertexArray(GLuint array)
+{
+	if (elide(vertexArray, array))
+		return;
+	FrameStats::Shared().VertexArrayBind();
+	if (Executes())
+		glBindVertexArray(array);
+	if (recording()) {
+		begin(OP_BIND_VERTEX_ARRAY, 1);
+		put(array);
+	}
+}
+
+void GLDispatch::BindBuffer(GLenum target, GLuint buffer)
+{
+	// Only the array buffer is shadowed, the element buffer belongs to the vertex array and the uniform ring binds directly
+	if (target == GL_ARRAY_BUFFER && elide(arrayBuffer, buffer))
+		return;
+	FrameStats::Shared().BufferBind();
+	if (Executes())
+		glBindBuffer(target, buffer);
+	if (recording()) {
+		begin(OP_BIND_BUFFER, 2);
+		put(target);
+		put(buffer);
+	}
+}
+
+void GLDispatch::BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+{
+	FrameStats::Shared().Upload(size);
+	if (Executes())
+		glBufferSubData(target, offset, size, data);
+	if (recording()) {
+		begin(OP_BUFFER_SUB_DATA, 3 + payloadWords(size));
+		put(target);
+		put((uint32_t)offset);
+		put((uint32_t)size);
+		putData(data, size);
+	}
+}
+
+void GLDispatch::ActiveTexture(GLenum unit)
+{
+	if (elide(activeUnit, unit))
+		return;
+	if (Executes())
+		glActiveTexture(unit);
+	if (recording()) {
+		begin(OP_ACTIVE_TEXTURE, 1);
+		put(unit);
+	}
+}
+
+void GLDispatch::BindTexture(GLenum target, GLuint texture)
+{
+	// 2D textures on the first units are shadowed, once the active unit is known
+	const GLuint unit = activeUnit - GL_TEXTURE0;
+	if (target == GL_TEXTURE_2D && activeUnit != UNKNOWN && unit < TEXTURE_UNITS && elide(textures[unit], texture))
+		return;
+	FrameStats::Shared().TextureBind();
+	if (Executes())
+		glBindTexture(target, texture);
+	if (recording()) {
+		begin(OP_BIND_TEXTURE, 2);
+		put(target);
+		put(texture);
+	}
+}
+
+void GLDispatch::Uniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z)
+{
+	if (Executes())
+		glUniform3f(location, x, y, z);
+	if (recording()) {
+		begin(OP_UNIFORM_3F, 4);
+		put((uint32_t)location);
+		putFloat(x);
+		putFloat(y);
+		putFloat(z);
+	}
+}
+
+void GLDispatch::Enable(GLenum capability)
+{
+	const int slot = GLDispatch::capability(capability);
+	if (slot >= 0 && elide(enabled[slot], 1))
+		return;
+	if (Executes())
+		glEnable(capability);
+	if (recording()) {
+		begin(OP_ENABLE, 1);
+		put(capability);
+	}
+}
+
+void GLDispatch::Disable(GLenum capability)
+{
+	const int slot = GLDispatch::capability(capability);
+	if (slot >= 0 && elide(enabled[slot], 0))
+		return;
+	if (Executes())
+		glDisable(capability);
+	if (recording()) {
+		begin(OP_DISABLE, 1);
+		put(capability);
+	}
+}
+
+void GLDispatch::ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a)
+{
+	if (Executes())
+		glClearColor(r, g, b, a);
+	if (recording()) {
+		begin(OP_CLEAR_COLOR, 4);
+		putFloat(r);
+		putFloat(g);
+		putFloat(b);
+		putFloat(a);
+	}
+}
+
+void GLDispatch::Clear(GLbitfield mask)
+{
+	if (Executes())
+		glClear(mask);
+	if (recording()) {
+		begin(OP_CLEAR, 1);
+		put(mask);
+	}
+}
+
+void GLDispatch::DrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+	if (Executes())
+		glDrawArrays(mode, first, count);
+	if (recording()) {
+		begin(OP_DRAW_ARRAYS, 3);
+		put(mode);
+		put((uint32_t)first);
+		put((uint32_t)count);
+	}
+}
+
+void GLDispatch::DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, GLintptr offset, GLint baseVertex)
+{
+	if (Executes())
+		glDrawElementsBaseVertex(mode, count, type, (GLvoid*)offset, baseVertex);
+	if (recording()) {
+		begin(OP_DRAW_ELEMENTS_BASE_VERTEX, 5);
+		put(mode);
+		put((uint32_t)count);
+		put(type);
+		put((uint32_t)offset);
+		put((uint32_t)baseVertex);
+	}
+}
+
+void GLDispatch::DrawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, GLintptr offset, GLsizei instances, GLint baseVertex)
+{
+	if (Executes())
+		glDrawElementsInstancedBaseVertex(mode, count, type, (GLvoid*)offset, instances, baseVertex);
+	if (recording()) {
+		begin(OP_DRAW_ELEMENTS_INSTANCED_BASE_VERTEX, 6);
+		put(mode);
+		put((uint32_t)count);
+		put(type);
+		put((uint32_t)offset);
+		put((uint32_t)instances);
+		put((uint32_t)baseVertex);
+	}
+}
+
+void GLDispatch::UniformBlock(GLuint binding, const void* data, GLsizeiptr size)
+{
+	if (Executes()) {
+		UniformRing::Shared().PushAndBind(binding, data, size);
+	}
+	else {
+		// Counted as if it went through the ring, so null frames report the same uploads
+		FrameStats::Shared().Upload(size);
+		FrameStats::Shared().BufferBind();
+	}
+	if (recording()) {
+		begin(OP_UNIFORM_BLOCK, 2 + payloadWords(size));
+		put(binding);
+		put((uint32_t)size);
+		putData(data, size);
+	}
+}
+
+size_t GLDispatch::StageBlock(const void* data, GLsizeiptr size)
+{
+	if (Executes())
+		UniformRing::Shared().Stage(data, size);
+	else
+		FrameStats::Shared().Upload(size);
+	if (recording()) {
+		begin(OP_STAGE_BLOCK, 1 + payloadWords(size));
+		put((uint32_t)size);
+		putData(data, size);
+	}
+	return stagedBlocks++;
+}
+
+void GLDispatch::FlushBlocks()
+{
+	if (Executes())
+		UniformRing::Shared().Flush();
+	if (recording())
+		begin(OP_FLUSH_BLOCKS, 0);
+}
+
+void GLDispatch::BindBlock(GLuint binding, size_t block)
+{
+	if (Executes())
+		UniformRing::Shared().Bind(binding, block);
+	else
+		FrameStats::Shared().BufferBind();
+	if (recording()) {
+		begin(OP_BIND_BLOCK, 2);
+		put(binding);
+		put((uint32_t)block);
+	}
+}
+
+void GLDispatch::Execute(const uint32_t* words, size_t count)
+{
+	UniformRing::Shared().BeginFrame();
+	size_t i = 0;
+	while (i < count) {
+		const uint32_t op = words[i] >> 24, length = words[i] & 0xFFFFFF;
+		const uint32_t* a = &words[i + 1];
+		if (i + 1 + length > count)
+			break;
+
+		switch (op) {
+		case OP_USE_PROGRAM:
+			glUseProgram(a[0]);
+			break;
+		case OP_BIND_VERTEX_ARRAY:
+			glBindVertexArray(a[0]);
+			break;
+		case OP_BIND_BUFFER:
+			glBindBuffer(a[0], a[1]);
+			break;
+		case OP_BUFFER_SUB_DATA:
+			glBufferSubData(a[0], a[1], a[2], &a[3]);
+			break;
+		case OP_ACTIVE_TEXTURE:
+			glActiveTexture(a[0]);
+			break;
+		case OP_BIND_TEXTURE:
+			glBindTexture(a[0], a[1]);
+			break;
+		case OP_UNIFORM_3F:
+			glUniform3f((GLint)a[0], getFloat(a[1]), getFloat(a[2]), getFloat(a[3]));
+			break;
+		case OP_CLEAR_COLOR:
+			glClearColor(getFloat(a[0]), getFloat(a[1]), getFloat(a[2]), getFloat(a[3]));
+			break;
+		case OP_CLEAR:
+			glClear(a[0]);
+			break;
+		case OP_DRAW_ARRAYS:
+			glDrawArrays(a[0], (GLint)a[1], (GLsizei)a[2]);
+			break;
+		case OP_DRAW_ELEMENTS_BASE_VERTEX:
+			glDrawElementsBaseVertex(a[0], (GLsizei)a[1], a[2], (GLvoid*)(uintptr_t)a[3], (GLint)a[4]);
+			break;
+		case OP_DRAW_ELEMENTS_INSTANCED_BASE_VERTEX:
+			glDrawElementsInstancedBaseVertex(a[0], (GLsizei)a[1], a[2], (GLvoid*)(uintptr_t)a[3], (GLsizei)a[4], (GLint)a[5]);
+			break;
+		case OP_UNIFORM_BLOCK:
+			UniformRing::Shared().PushAndBind(a[0], &a[2], a[1]);
+			break;
+		case OP_END_UNIFORMS:
+			UniformRing::Shared().EndFrame();
+			break;
+		case OP_ENABLE:
+			glEnable(a[0]);
+			break;
+		case OP_DISABLE:
+			glDisable(a[0]);
+			break;
+		case OP_STAGE_BLOCK:
+			UniformRing::Shared().Stage(&a[1], a[0]);
+			break;
+		case OP_FLUSH_BLOCKS:
+			UniformRing::Shared().Flush();
+			break;
+		case OP_BIND_BLOCK:
+			UniformRing::Shared().Bind(a[0], a[1]);
+			break;
+		default:
+			std::cout << "ERROR::GL DISPATCH:: Unknown command " << op << ", rest of the frame skipped" << std::endl;
+			return;
+		}
+		i += 1 + length;
+	}
+}
+
+GLDispatch& GLDispatch::Shared()
+{
+	static GLDispatch dispatch;
+	return dispatch;
+}
+
+int GLDispatch::capability(GLenum capability)
+{
+	switch (capability) {
+	case GL_DEPTH_TEST:
+		return 0;
+	case GL_CULL_FACE:
+		return 1;
+	case GL_BLEND:
+		return 2;
+	default:
+		return -1;
+	}
+}
+
+bool GLDispatch::elide(GLuint& shadow, GLuint value)
+{
+	if (shadow == value) {
+		FrameStats::Shared().ElidedCall();
+		return true;
+	}
+	shadow = value;
+	return false;
+}
+
+void GLDispatch::begin(Opcode op, size_t words)
+{
+	commands.push_back(((uint32_t)op << 24) | (uint32_t)words);
+	frameCommands++;
+}
+
+void GLDispatch::putFloat(float value)
+{
+	uint32_t word;
+	std::memcpy(&word, &value, sizeof(float));
+	commands.push_back(word);
+}
+
+void GLDispatch::putData(const void* data, size_t size)
+{
+	const size_t first = commands.size();
+	commands.resize(first + payloadWords(size), 0);
+	std::memcpy(&commands[first], data, size);
+}
+
+void GLDispatch::closeFrame()
+{
+	last.commands = frameCommands;
+	last.bytes = commands.size() * sizeof(uint32_t);
+	total.commands += last.commands;
+	total.bytes += last.bytes;
+	frames++;
+	if (file.is_open()) {
+		const uint32_t count = (uint32_t)commands.size();
+		file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+		file.write(reinterpret_cast<const char*>(commands.data()), commands.size() * sizeof(uint32_t));
+	}
+	commands.clear();
+	frameCommands = 0;
+}
+
+
+GLCommandReplay::GLCommandReplay() :
+	cursor(0)
+{
+}
+
+bool GLCommandReplay::Open(const std::string& path)
+{
+	std::ifstream file(path.c_str(), std::ios::binary);
+	if (!file) {
+		std::cout << "ERROR::GL DISPATCH:: Could not read " << path << std::endl;
+		return false;
+	}
+
+	char magic[4];
+	uint32_t version = 0;
+	if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, DISPATCH_MAGIC, sizeof(magic)) != 0
+		|| !file.read(reinterpret_cast<char*>(&version), sizeof(version)) || version < 1 || version > DISPATCH_VERSION) {
+		std::cout << "ERROR::GL DISPATCH:: " << path << " is not a version 1 to " << DISPATCH_VERSION << " command stream" << std::endl;
+		return false;
+	}
+
+	frames.clear();
+	uint32_t count;
+	while (file.read(reinterpret_cast<char*>(&count), sizeof(count))) {
+		std::vector<uint32_t> words(count);
+		if (count > 0 && !file.read(reinterpret_cast<char*>(&words[0]), count * sizeof(uint32_t))) {
+			std::cout << "ERROR::GL DISPATCH:: " << path << " ends part way through frame " << frames.size() << std::endl;
+			return false;
+		}
+		frames.push_back(words);
+	}
+	cursor = 0;
+	if (frames.empty()) {
+		std::cout << "ERROR::GL DISPATCH:: " << path << " has no frames" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool GLCommandReplay::Next()
+{
+	if (Finished())
+		return false;
+	const std::vector<uint32_t>& words = frames[cursor++];
+	GLDispatch::Execute(words.empty() ? NULL : &words[0], words.size());
+	return true;
+}
@@ -0,0 +1,181 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: GL Dispatch, the GL calls the draw path makes each frame, executed, recorded to a command stream or both
+
+// Std. Includes
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+// GL Includes
+#include <GL/glew.h>
+
+// What the dispatch does with a call
+enum DispatchMode {
+	DISPATCH_DIRECT,     // Straight to the driver
+	DISPATCH_NULL,       // Only recorded, the driver never sees the frame. Times the engine's own submission cost
+	DISPATCH_RECORD      // Executed and recorded
+};
+
+// One frame's recorded calls and what they cost to record
+struct DispatchCounters {
+	uint64_t commands;
+	uint64_t bytes;      // Command stream size, uniform and vertex data included
+};
+
+// Calls that change GL state or draw go through here instead of straight to GL. Resource creation and queries
+// (shaders, buffers, textures, uniform locations) still use GL directly, a null frame needs them to exist.
+//
+// A shadow copy of the bound program, vertex array, array buffer, textures and enable bits skips calls that
+// wouldn't change anything, they are neither executed nor recorded. Code that changes that state with GL directly
+// must Invalidate(), every frame starts invalidated so loading and compiling between frames can bind freely.
+//
+// Stream layout: 32-bit words, each command a header word (opcode << 24 | words that follow) and its arguments,
+// data payloads padded to whole words. A file is "LODG", uint32 version, then per frame a uint32 word count and the words
+class GLDispatch
+{
+public:
+	GLDispatch();
+
+	void SetMode(DispatchMode mode) { this->mode = mode; }
+	DispatchMode Mode() const { return mode; }
+
+	// False in null mode, for callers that would read results back (queries, fences)
+	bool Executes() const { return mode != DISPATCH_NULL; }
+
+	// Also write every recorded frame to a file, false and an error if it can't be written
+	bool RecordTo(const std::string& path);
+
+	// Start a frame: the last one is closed, its counters become Last(), the uniform ring rewinds and the shadow
+	// state is invalidated
+	void BeginFrame();
+
+	// The frame's uniform blocks are all written, fence the ring segment
+	void EndUniforms();
+
+	// Close the frame in progress, e.g. before exiting
+	void Finish();
+
+	// Drop the frame in progress unrecorded and uncounted, for a render that isn't one of the run's frames
+	void Discard();
+
+	// Forget the shadow state, the next call of each kind goes through
+	void Invalidate();
+
+	/*  State and draws  */
+	void UseProgram(GLuint program);
+	void BindVertexArray(GLuint array);
+	void BindBuffer(GLenum target, GLuint buffer);
+	void BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+	void ActiveTexture(GLenum unit);
+	void BindTexture(GLenum target, GLuint texture);
+	void Uniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z);
+	void Enable(GLenum capability);
+	void Disable(GLenum capability);
+	void ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a);
+	void Clear(GLbitfield mask);
+	void DrawArrays(GLenum mode, GLint first, GLsizei count);
+	void DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, GLintptr offset, GLint baseVertex);
+	void DrawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, GLintptr offset, GLsizei instances, GLint baseVertex);
+
+	// Copy a std140 block into the uniform ring and bind it, recorded with its data so a replay uploads the same values
+	void UniformBlock(GLuint binding, const void* data, GLsizeiptr size);
+
+	// A frame's blocks: staged first, uploaded together by FlushBlocks before the draws, then bound by index
+	size_t StageBlock(const void* data, GLsizeiptr size);
+	void FlushBlocks();
+	void BindBlock(GLuint binding, size_t block);
+
+	// Counters of the last closed frame, and summed over every closed frame
+	const DispatchCounters& Last() const { return last; }
+	const DispatchCounters& Total() const { return total; }
+	uint64_t Frames() const { return frames; }
+
+	// Commands of the frame being recorded
+	const std::vector<uint32_t>& Commands() const { return commands; }
+
+	// Run a recorded frame against the current context, the uniform ring wraps it like a live frame
+	static void Execute(const uint32_t* words, size_t count);
+
+	// Dispatch the draw path uses
+	static GLDispatch& Shared();
+
+private:
+	enum Opcode {
+		OP_USE_PROGRAM,
+		OP_BIND_VERTEX_ARRAY,
+		OP_BIND_BUFFER,
+		OP_BUFFER_SUB_DATA,
+		OP_ACTIVE_TEXTURE,
+		OP_BIND_TEXTURE,
+		OP_UNIFORM_3F,
+		OP_CLEAR_COLOR,
+		OP_CLEAR,
+		OP_DRAW_ARRAYS,
+		OP_DRAW_ELEMENTS_BASE_VERTEX,
+		OP_DRAW_ELEMENTS_INSTANCED_BASE_VERTEX,
+		OP_UNIFORM_BLOCK,
+		OP_END_UNIFORMS,
+		OP_ENABLE,
+		OP_DISABLE,
+		OP_STAGE_BLOCK,
+		OP_FLUSH_BLOCKS,
+		OP_BIND_BLOCK
+	};
+
+	static const GLuint UNKNOWN = 0xFFFFFFFF;    // Shadow value that matches no real name
+	static const int TEXTURE_UNITS = 16;         // Units shadowed, binds to higher ones always go through
+	static const int CAPABILITIES = 3;           // Enable bits shadowed: depth test, face culling, blending
+
+	// Shadow slot of an enable bit, -1 when it isn't shadowed
+	static int capability(GLenum capability);
+	bool elide(GLuint& shadow, GLuint value);
+
+	bool recording() const { return mode != DISPATCH_DIRECT; }
+	void begin(Opcode op, size_t words);
+	void put(uint32_t word) { commands.push_back(word); }
+	void putFloat(float value);
+	void putData(const void* data, size_t size);
+	void closeFrame();
+
+	/*  Shadow state  */
+	GLuint program;
+	GLuint vertexArray;
+	GLuint arrayBuffer;
+	GLuint activeUnit;
+	GLuint textures[TEXTURE_UNITS];
+	GLuint enabled[CAPABILITIES];    // 1, 0, or UNKNOWN
+
+	/*  Dispatch data  */
+	DispatchMode mode;
+	std::vector<uint32_t> commands;
+	uint64_t frameCommands;
+	DispatchCounters last, total;
+	uint64_t frames;
+	size_t stagedBlocks;    // Blocks staged this frame, the index the next one gets
+	bool started;
+	std::ofstream file;
+};
+
+// Plays a recorded command stream back one frame at a time
+class GLCommandReplay
+{
+public:
+	GLCommandReplay();
+
+	// Read a whole stream, false and an error if it's missing or malformed
+	bool Open(const std::string& path);
+
+	// Execute the next frame against the current context, false after the last one
+	bool Next();
+
+	bool Finished() const { return cursor >= frames.size(); }
+	size_t Frames() const { return frames.size(); }
+
+private:
+	/*  Replay data  */
+	std::vector<std::vector<uint32_t> > frames;
+	size_t cursor;
+};
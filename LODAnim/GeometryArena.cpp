@@ -0,0 +1,252 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Geometry Arena, one shared vertex/index buffer for every Mesh
+
+// Std. Includes
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstddef>
+#include <cmath>
+
+// custom Includes
+#include "GeometryArena.h"
+#include "GLDispatch.h"
+
+static bool sharedPacked = false;
+static bool sharedCPUOnly = false;
+
+// Signed normalised 10:10:10:2, x in the low bits
+static GLuint packNormal(const glm::vec3& normal)
+{
+	GLuint packed = 0;
+	for (int i = 0; i < 3; i++) {
+		float component = normal[i] < -1.0f ? -1.0f : (normal[i] > 1.0f ? 1.0f : normal[i]);
+		GLint value = (GLint)floorf(component * 511.0f + 0.5f);
+		packed |= ((GLuint)value & 0x3FF) << (10 * i);
+	}
+	return packed;
+}
+
+GeometryArena::GeometryArena(GLuint vertexCapacity, GLuint indexCapacity, bool packed) :
+	VAO(0), VBO(0), EBO(0), allocations(0), packed(packed), stride(packed ? sizeof(PackedVertex) : sizeof(Vertex))
+{
+	vertexPool.Reset(vertexCapacity);
+	indexPool.Reset(indexCapacity);
+
+	// Create buffers/arrays
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &EBO);
+
+	// Reserve storage up front, meshes are copied in with glBufferSubData
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)vertexCapacity * stride, NULL, GL_STATIC_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)indexCapacity * sizeof(GLuint), NULL, GL_STATIC_DRAW);
+	setupAttributes();
+	glBindVertexArray(0);
+}
+
+ArenaRange GeometryArena::Allocate(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices)
+{
+	GLuint vertexCount = (GLuint)vertices.size(), indexCount = (GLuint)indices.size();
+	GLuint vertexOffset, indexOffset;
+
+	// Double the buffers until the mesh fits
+	while (!vertexPool.Take(vertexCount, vertexOffset)) {
+		GLuint newCapacity = std::max(vertexPool.capacity * 2, vertexPool.capacity + vertexCount);
+		growBuffer(GL_ARRAY_BUFFER, VBO, (GLsizeiptr)vertexPool.capacity * stride, (GLsizeiptr)newCapacity * stride);
+		vertexPool.Grow(newCapacity);
+	}
+	while (!indexPool.Take(indexCount, indexOffset)) {
+		GLuint newCapacity = std::max(indexPool.capacity * 2, indexPool.capacity + indexCount);
+		growBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO, (GLsizeiptr)indexPool.capacity * sizeof(GLuint), (GLsizeiptr)newCapacity * sizeof(GLuint));
+		indexPool.Grow(newCapacity);
+	}
+
+	// Copy mesh data into its slice of the shared buffers
+	glBindVertexArray(VAO);
+	if (vertexCount > 0) {
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		if (packed) {
+			std::vector<PackedVertex> packedVertices(vertexCount);
+			for (GLuint i = 0; i < vertexCount; i++) {
+				packedVertices[i].Position = vertices[i].Position;
+				packedVertices[i].Normal = packNormal(vertices[i].Normal);
+			}
+			glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)vertexOffset * stride, vertexCount * stride, &packedVertices[0]);
+		}
+		else {
+			glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)vertexOffset * stride, vertexCount * stride, &vertices[0]);
+		}
+	}
+	if (indexCount > 0)
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)indexOffset * sizeof(GLuint), indexCount * sizeof(GLuint), &indices[0]);
+	glBindVertexArray(0);
+
+	allocations++;
+	ArenaRange range = { (GLint)vertexOffset, vertexCount, indexOffset, (GLsizei)indexCount };
+	return range;
+}
+
+void GeometryArena::Free(const ArenaRange& range)
+{
+	vertexPool.Give((GLuint)range.baseVertex, range.vertexCount);
+	indexPool.Give(range.firstIndex, (GLuint)range.indexCount);
+	allocations--;
+}
+
+void GeometryArena::Bind()
+{
+	GLDispatch::Shared().BindVertexArray(VAO);
+}
+
+void GeometryArena::Report(std::ostream& out) const
+{
+	const Pool* pools[] = { &vertexPool, &indexPool };
+	const char* names[] = { "Vertices", "Indices" };
+	const size_t strides[] = { (size_t)stride, sizeof(GLuint) };
+
+	out << "GEOMETRY ARENA: " << allocations << " meshes in 1 VAO, " << stride << " byte "
+		<< (packed ? "packed" : "float") << " vertices" << std::endl;
+	for (int i = 0; i < 2; i++) {
+		const Pool& pool = *pools[i];
+		out << "  " << std::left << std::setw(9) << names[i]
+			<< pool.used * strides[i] << " / " << (size_t)pool.capacity * strides[i] << " bytes used, "
+			<< pool.freeList.size() << " free blocks, largest " << pool.LargestFree() * strides[i] << " bytes, "
+			<< std::fixed << std::setprecision(1) << pool.Fragmentation() * 100.0f << "% fragmented" << std::endl;
+	}
+}
+
+GeometryArena& GeometryArena::Shared()
+{
+	// Sized for the full LOD chain and orbit ring; grows if a bigger scene is loaded
+	static GeometryArena arena(1 << 18, 1 << 20, sharedPacked);
+	return arena;
+}
+
+void GeometryArena::UsePackedVertices(bool packed)
+{
+	sharedPacked = packed;
+}
+
+void GeometryArena::UseCPUOnly(bool cpuOnly)
+{
+	sharedCPUOnly = cpuOnly;
+}
+
+bool GeometryArena::CPUOnly()
+{
+	return sharedCPUOnly;
+}
+
+// Vertex layout matches the one Mesh used to set up per VAO
+void GeometryArena::setupAttributes()
+{
+	// Vertex Positions
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, (GLsizei)stride, (GLvoid*)0);
+	// Vertex Normals
+	glEnableVertexAttribArray(1);
+	if (packed)
+		glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, (GLsizei)stride, (GLvoid*)offsetof(PackedVertex, Normal));
+	else
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, (GLsizei)stride, (GLvoid*)offsetof(Vertex, Normal));
+}
+
+// Reallocate a buffer with more storage, copying the old contents on the GPU
+void GeometryArena::growBuffer(GLenum target, GLuint& buffer, GLsizeiptr oldBytes, GLsizeiptr newBytes)
+{
+	GLuint bigger;
+	glGenBuffers(1, &bigger);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, bigger);
+	glBufferData(GL_COPY_WRITE_BUFFER, newBytes, NULL, GL_STATIC_DRAW);
+	glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+	glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, oldBytes);
+	glDeleteBuffers(1, &buffer);
+	buffer = bigger;
+
+	// Re-point the VAO at the new storage
+	glBindVertexArray(VAO);
+	glBindBuffer(target, buffer);
+	if (target == GL_ARRAY_BUFFER)
+		setupAttributes();
+	glBindVertexArray(0);
+}
+
+/// POOL ---------------------------------------------------------------------------------------------------
+/// --------------------------------------------------------------------------------------------------------
+void GeometryArena::Pool::Reset(GLuint newCapacity)
+{
+	capacity = newCapacity;
+	used = 0;
+	freeList.clear();
+	Block all = { 0, newCapacity };
+	freeList.push_back(all);
+}
+
+bool GeometryArena::Pool::Take(GLuint count, GLuint& offset)
+{
+	// First fit, keeps low offsets packed and leaves the tail free for growth
+	for (size_t i = 0; i < freeList.size(); i++) {
+		if (freeList[i].count >= count) {
+			offset = freeList[i].offset;
+			freeList[i].offset += count;
+			freeList[i].count -= count;
+			if (freeList[i].count == 0)
+				freeList.erase(freeList.begin() + i);
+			used += count;
+			return true;
+		}
+	}
+	return false;
+}
+
+void GeometryArena::Pool::Give(GLuint offset, GLuint count)
+{
+	if (count == 0)
+		return;
+	used -= count;
+
+	// Insert in offset order, then merge with the neighbours on either side
+	Block block = { offset, count };
+	std::vector<Block>::iterator it = std::lower_bound(freeList.begin(), freeList.end(), block,
+		[](const Block& a, const Block& b) { return a.offset < b.offset; });
+	it = freeList.insert(it, block);
+	if (it + 1 != freeList.end() && it->offset + it->count == (it + 1)->offset) {
+		it->count += (it + 1)->count;
+		freeList.erase(it + 1);
+	}
+	if (it != freeList.begin() && (it - 1)->offset + (it - 1)->count == it->offset) {
+		(it - 1)->count += it->count;
+		freeList.erase(it);
+	}
+}
+
+void GeometryArena::Pool::Grow(GLuint newCapacity)
+{
+	GLuint extra = newCapacity - capacity;
+	GLuint oldCapacity = capacity;
+	capacity = newCapacity;
+	used += extra; // Give() subtracts it again
+	Give(oldCapacity, extra);
+}
+
+GLuint GeometryArena::Pool::LargestFree() const
+{
+	GLuint largest = 0;
+	for (size_t i = 0; i < freeList.size(); i++)
+		largest = std::max(largest, freeList[i].count);
+	return largest;
+}
+
+// 0 when all free space is one block, approaching 1 as it splinters
+float GeometryArena::Pool::Fragmentation() const
+{
+	GLuint free = capacity - used;
+	if (free == 0)
+		return 0.0f;
+	return 1.0f - (float)LargestFree() / (float)free;
+}
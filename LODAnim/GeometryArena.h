@@ -0,0 +1,93 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Geometry Arena, one shared vertex/index buffer for every Mesh
+
+// Std. Includes
+#include <vector>
+#include <ostream>
+
+// GL Includes
+#include <GL/glew.h>
+
+// custom Includes
+#include "Vertex.h"
+
+// Location of a Mesh inside the arena buffers
+struct ArenaRange {
+	GLint baseVertex;   // First vertex of the mesh, added to every index by glDrawElementsBaseVertex
+	GLuint vertexCount; // Number of vertices owned by the mesh
+	GLuint firstIndex;  // First index of the mesh in the element buffer
+	GLsizei indexCount; // Number of indices owned by the mesh
+};
+
+class GeometryArena
+{
+public:
+	// Constructor, capacities are given in vertices and indices. Packed arenas store
+	// normals as 10:10:10:2 (16 byte vertices instead of 24)
+	GeometryArena(GLuint vertexCapacity, GLuint indexCapacity, bool packed = false);
+
+	// Copy a mesh into the arena, growing the buffers if it doesn't fit
+	ArenaRange Allocate(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices);
+
+	// Return a mesh's space to the arena
+	void Free(const ArenaRange& range);
+
+	// Bind the single VAO every arena mesh is drawn from
+	void Bind();
+
+	// Print bytes used, capacity and fragmentation of both buffers
+	void Report(std::ostream& out) const;
+
+	// True if vertices are stored with packed normals, shaders need VARIANT_PACKED
+	bool Packed() const { return packed; }
+
+	// Arena used by every Mesh, created on first use (requires a current GL context)
+	static GeometryArena& Shared();
+
+	// Choose the Shared() arena's vertex format, only before the first Mesh is loaded
+	static void UsePackedVertices(bool packed);
+
+	// Keep every Mesh on the CPU only, for backends without a GL context. Before the first Mesh is loaded
+	static void UseCPUOnly(bool cpuOnly);
+	static bool CPUOnly();
+
+private:
+	// A contiguous run of free elements
+	struct Block {
+		GLuint offset;
+		GLuint count;
+	};
+
+	// First-fit suballocator over a buffer measured in elements
+	struct Pool {
+		GLuint capacity;
+		GLuint used;
+		std::vector<Block> freeList; // Sorted by offset, neighbours always coalesced
+
+		void Reset(GLuint capacity);
+		bool Take(GLuint count, GLuint& offset);
+		void Give(GLuint offset, GLuint count);
+		void Grow(GLuint newCapacity);
+		GLuint LargestFree() const;
+		float Fragmentation() const;
+	};
+
+	// Position as floats, normal as a signed normalised GL_INT_2_10_10_10_REV
+	struct PackedVertex {
+		glm::vec3 Position;
+		GLuint Normal;
+	};
+
+	/*  Render data  */
+	GLuint VAO, VBO, EBO;
+	Pool vertexPool, indexPool;
+	GLuint allocations;
+	bool packed;
+	GLsizeiptr stride;
+
+	/*  Functions    */
+	void setupAttributes();
+	void growBuffer(GLenum target, GLuint& buffer, GLsizeiptr oldBytes, GLsizeiptr newBytes);
+};
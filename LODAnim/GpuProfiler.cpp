@@ -0,0 +1,140 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: GPU Profiler, per render pass GPU time from timestamp queries read back a few frames late
+
+// Std. Includes
+#include <cstring>
+
+// custom Includes
+#include "GpuProfiler.h"
+#include "Profiler.h"
+#include "GLDispatch.h"
+
+
+// Timestamps rather than GL_TIME_ELAPSED, which can't overlap, so passes can be interleaved and repeat within a frame
+GpuProfiler::GpuProfiler() :
+	current(0), open(false), suspended(false)
+{
+	for (int i = 0; i < LATENCY; i++) {
+		glGenQueries(MAX_QUERIES, frames[i].queries);
+		frames[i].used = 0;
+		frames[i].pending = false;
+	}
+
+	// Sample both clocks together, GPU timestamps are then placed on the CPU trace timeline
+	GLint64 gpuNow = 0;
+	glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+	clockOffset = gpuNow - (int64_t)Profiler::Now();
+	track = Profiler::Shared().AddTrack("GPU");
+}
+
+GpuProfiler& GpuProfiler::Shared()
+{
+	static GpuProfiler profiler;
+	return profiler;
+}
+
+void GpuProfiler::Begin(const char* pass)
+{
+	Frame& frame = frames[current];
+
+	// Every frame still in flight, or out of queries, drop the pass rather than stall. Null frames never reach the GPU
+	if (suspended || !GLDispatch::Shared().Executes() || open || frame.pending || frame.used + 2 > MAX_QUERIES)
+		return;
+	frame.names[frame.used / 2] = pass;
+	glQueryCounter(frame.queries[frame.used++], GL_TIMESTAMP);
+	open = true;
+}
+
+void GpuProfiler::End()
+{
+	if (!open)
+		return;
+	Frame& frame = frames[current];
+	glQueryCounter(frame.queries[frame.used++], GL_TIMESTAMP);
+	open = false;
+}
+
+void GpuProfiler::EndFrame()
+{
+	// Hand this frame over, then move to the oldest slot
+	if (frames[current].used > 0)
+		frames[current].pending = true;
+	current = (current + 1) % LATENCY;
+
+	for (int i = 0; i < LATENCY; i++) {
+		Frame& frame = frames[(current + i) % LATENCY];
+		if (!frame.pending)
+			continue;
+
+		// The last timestamp lands after every earlier one in the frame
+		GLint available = 0;
+		glGetQueryObjectiv(frame.queries[frame.used - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available)
+			continue;
+		read(frame);
+	}
+}
+
+double GpuProfiler::PassMs(const char* pass) const
+{
+	for (size_t i = 0; i < passes.size(); i++)
+		if (std::strcmp(passes[i].name, pass) == 0)
+			return passes[i].averageMs;
+	return 0.0;
+}
+
+void GpuProfiler::Reset()
+{
+	for (size_t i = 0; i < passes.size(); i++) {
+		passes[i].averageMs = 0.0;
+		passes[i].samples = 0;
+	}
+}
+
+void GpuProfiler::read(Frame& frame)
+{
+	GLuint64 stamps[MAX_QUERIES];
+	for (int i = 0; i < frame.used; i++)
+		glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &stamps[i]);
+
+	// Sum each pass over the frame, every segment also goes on the trace's GPU track
+	std::vector<double> frameMs(passes.size(), 0.0);
+	std::vector<bool> ran(passes.size(), false);
+	for (int i = 0; i + 1 < frame.used; i += 2) {
+		GpuPassStats& p = pass(frame.names[i / 2]);
+		size_t index = &p - &passes[0];
+		frameMs.resize(passes.size(), 0.0);
+		ran.resize(passes.size(), false);
+		frameMs[index] += (stamps[i + 1] - stamps[i]) / 1000000.0;
+		ran[index] = true;
+
+		Profiler::Shared().Record(track, frame.names[i / 2], stamps[i] - clockOffset, stamps[i + 1] - clockOffset);
+	}
+
+	// Exponential moving average, smooth enough to read on screen
+	for (size_t i = 0; i < ran.size(); i++) {
+		if (!ran[i])
+			continue;
+		GpuPassStats& p = passes[i];
+		p.averageMs = p.samples == 0 ? frameMs[i] : p.averageMs * 0.95 + frameMs[i] * 0.05;
+		p.samples++;
+	}
+
+	frame.used = 0;
+	frame.pending = false;
+}
+
+GpuPassStats& GpuProfiler::pass(const char* name)
+{
+	for (size_t i = 0; i < passes.size(); i++)
+		if (std::strcmp(passes[i].name, name) == 0)
+			return passes[i];
+
+	GpuPassStats p;
+	p.name = name;
+	p.averageMs = 0.0;
+	p.samples = 0;
+	passes.push_back(p);
+	return passes.back();
+}
@@ -0,0 +1,71 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: GPU Profiler, per render pass GPU time from timestamp queries read back a few frames late
+
+// Std. Includes
+#include <vector>
+#include <cstdint>
+
+// GL Includes
+#include <GL/glew.h>
+
+// Rolling GPU time of one pass, summed over every time it ran in a frame
+struct GpuPassStats {
+	const char* name;
+	double averageMs;
+	int samples;
+};
+
+class GpuProfiler
+{
+public:
+	// Constructor, creates the query objects (requires a current GL context)
+	GpuProfiler();
+
+	// Time the draws issued between Begin and End as part of a pass, passes don't nest
+	void Begin(const char* pass);
+	void End();
+
+	// Once per frame after the last pass: read back finished frames without waiting, start the next
+	void EndFrame();
+
+	// Rolling average of a pass in milliseconds, 0 until its first result
+	double PassMs(const char* pass) const;
+
+	// Every pass seen, in first-seen order
+	const std::vector<GpuPassStats>& Passes() const { return passes; }
+
+	// Forget the history, e.g. after switching what is being measured
+	void Reset();
+
+	// Ignore Begin / End while suspended, for draws that aren't part of the frame being measured
+	void Suspend(bool suspended) { this->suspended = suspended; }
+
+	// Single profiler for the window's context
+	static GpuProfiler& Shared();
+
+private:
+	static const int LATENCY = 3;        // Frames a query result is allowed to lag behind
+	static const int MAX_QUERIES = 256;  // Timestamps per frame, two per Begin / End
+
+	// One frame's timestamps
+	struct Frame {
+		GLuint queries[MAX_QUERIES];
+		const char* names[MAX_QUERIES / 2];
+		int used;
+		bool pending;            // Issued, results not read yet
+	};
+
+	void read(Frame& frame);
+	GpuPassStats& pass(const char* name);
+
+	/*  Profiler data  */
+	Frame frames[LATENCY];
+	int current;
+	bool open;
+	bool suspended;
+	std::vector<GpuPassStats> passes;
+	int64_t clockOffset;     // GPU timestamp minus Profiler::Now, lines GPU passes up with CPU zones
+	int track;
+};
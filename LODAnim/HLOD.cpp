@@ -0,0 +1,134 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: HLOD, clusters of a static field merged into one simplified proxy mesh each, drawn in place of the cluster when far
+
+// Std. Includes
+#include <cmath>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+
+// custom Includes
+#include "HLOD.h"
+#include "LevelOfDetail.h"
+#include "Profiler.h"
+
+// Grid cell of a position, 21 bits per axis holds the field many times over even at HLOD_WELD
+static uint64_t cellKey(glm::vec3 position, float cell)
+{
+	const uint64_t bias = 1 << 20;
+	const uint64_t x = (uint64_t)((int64_t)std::floor(position.x / cell) + bias) & 0x1FFFFF;
+	const uint64_t y = (uint64_t)((int64_t)std::floor(position.y / cell) + bias) & 0x1FFFFF;
+	const uint64_t z = (uint64_t)((int64_t)std::floor(position.z / cell) + bias) & 0x1FFFFF;
+	return x << 42 | y << 21 | z;
+}
+
+
+HLOD::HLOD() :
+	sourceTriangles(0), proxyTriangles(0), buildMs(0.0), frames(0), proxiesDrawn(0), bodiesReplaced(0)
+{
+}
+
+void HLOD::Build(const std::vector<glm::vec3>& positions, const Mesh& mesh, float radius)
+{
+	PROFILE_ZONE("HLOD Build");
+	const uint64_t start = Profiler::Now();
+	Clear();
+
+	// Ordered by cell, so the same field always gives the same clusters
+	std::map<uint64_t, std::vector<int> > cells;
+	for (size_t i = 0; i < positions.size(); i++)
+		cells[cellKey(positions[i], HLOD_CELL)].push_back((int)i);
+
+	for (auto& cell : cells) {
+		HLODCluster cluster;
+		cluster.members.swap(cell.second);
+		cluster.centre = glm::vec3(0.0f);
+		for (int member : cluster.members)
+			cluster.centre += positions[member];
+		cluster.centre /= (float)cluster.members.size();
+		cluster.radius = 0.0f;
+		for (int member : cluster.members)
+			cluster.radius = std::max(cluster.radius, glm::length(positions[member] - cluster.centre) + radius);
+
+		cluster.proxy = -1;
+		if ((int)cluster.members.size() >= HLOD_MIN_MEMBERS) {
+			cluster.proxy = (int)proxies.size();
+			proxies.push_back(buildProxy(cluster, positions, mesh));
+			sourceTriangles += cluster.members.size() * mesh.indices.size() / 3;
+			proxyTriangles += proxies.back().indices.size() / 3;
+		}
+		clusters.push_back(cluster);
+	}
+	buildMs = (Profiler::Now() - start) / 1e6;
+}
+
+void HLOD::Select(glm::vec3 eye, float distance, std::vector<int>& near, std::vector<const Mesh*>& far)
+{
+	for (const HLODCluster& cluster : clusters) {
+		// Nearest any member can be, so no body a proxy replaces would have been drawn finer
+		if (cluster.proxy >= 0 && EuclideanDistance(cluster.centre, eye) - cluster.radius > distance) {
+			far.push_back(&proxies[cluster.proxy]);
+			bodiesReplaced += cluster.members.size();
+		}
+		else
+			near.insert(near.end(), cluster.members.begin(), cluster.members.end());
+	}
+	proxiesDrawn += far.size();
+	frames++;
+}
+
+void HLOD::Clear()
+{
+	for (Mesh& proxy : proxies)
+		proxy.Release();
+	proxies.clear();
+	clusters.clear();
+	sourceTriangles = proxyTriangles = 0;
+	frames = proxiesDrawn = bodiesReplaced = 0;
+}
+
+Mesh HLOD::buildProxy(const HLODCluster& cluster, const std::vector<glm::vec3>& positions, const Mesh& mesh)
+{
+	// One vertex per occupied weld cell, at the mean position and normal of every vertex that fell in it
+	std::unordered_map<uint64_t, GLuint> welded;
+	std::vector<Vertex> vertices;
+	std::vector<float> weights;
+	std::vector<GLuint> remap(mesh.vertices.size());
+	std::vector<GLuint> indices;
+	indices.reserve(cluster.members.size() * mesh.indices.size());
+
+	for (int member : cluster.members) {
+		for (size_t i = 0; i < mesh.vertices.size(); i++) {
+			const glm::vec3 position = mesh.vertices[i].Position + positions[member];
+			auto cell = welded.insert(std::make_pair(cellKey(position, HLOD_WELD), (GLuint)vertices.size()));
+			if (cell.second) {
+				Vertex vertex = { glm::vec3(0.0f), glm::vec3(0.0f) };
+				vertices.push_back(vertex);
+				weights.push_back(0.0f);
+			}
+			const GLuint index = cell.first->second;
+			vertices[index].Position += position;
+			vertices[index].Normal += mesh.vertices[i].Normal;
+			weights[index] += 1.0f;
+			remap[i] = index;
+		}
+
+		// Triangles a weld cell swallowed an edge of are gone
+		for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+			const GLuint a = remap[mesh.indices[i]], b = remap[mesh.indices[i + 1]], c = remap[mesh.indices[i + 2]];
+			if (a == b || b == c || a == c)
+				continue;
+			indices.push_back(a);
+			indices.push_back(b);
+			indices.push_back(c);
+		}
+	}
+
+	for (size_t i = 0; i < vertices.size(); i++) {
+		vertices[i].Position /= weights[i];
+		const float length = glm::length(vertices[i].Normal);
+		vertices[i].Normal = length > 0.0f ? vertices[i].Normal / length : glm::vec3(0.0f, 0.0f, 1.0f);
+	}
+	return Mesh(vertices, indices);
+}
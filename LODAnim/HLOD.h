@@ -0,0 +1,67 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: HLOD, clusters of a static field merged into one simplified proxy mesh each, drawn in place of the cluster when far
+
+// Std. Includes
+#include <vector>
+#include <cstdint>
+
+// GL Includes
+#include <glm/glm.hpp>
+
+// custom Includes
+#include "Mesh.h"
+
+// Side of the grid cells bodies are clustered by, world units
+const float HLOD_CELL = 25.0f;
+
+// Side of the vertex clustering grid that simplifies a proxy, half a body across. Leaves about 30% of LOD4's triangles
+const float HLOD_WELD = 1.0f;
+
+// Fewer members than this aren't worth a proxy, they stay in the per-level instanced draws
+const int HLOD_MIN_MEMBERS = 4;
+
+// Bodies close together and the proxy that replaces them
+struct HLODCluster {
+	glm::vec3 centre;
+	float radius;               // Bounds every member's mesh
+	std::vector<int> members;   // Indices into the positions the clusters were built from
+	int proxy;                  // Index of the proxy mesh, -1 when the cluster has none
+};
+
+class HLOD
+{
+public:
+	HLOD();
+
+	// Cluster positions on a grid of HLOD_CELL and build each cluster's proxy from mesh placed at every member,
+	// merged and simplified on a grid of HLOD_WELD. radius bounds mesh. Replaces any earlier build
+	void Build(const std::vector<glm::vec3>& positions, const Mesh& mesh, float radius);
+
+	// Proxies of the clusters entirely beyond distance of eye into far, the members of every other cluster into near
+	void Select(glm::vec3 eye, float distance, std::vector<int>& near, std::vector<const Mesh*>& far);
+
+	// Give the proxies' geometry back
+	void Clear();
+
+	/*  Statistics  */
+	size_t Clusters() const { return clusters.size(); }
+	size_t Proxies() const { return proxies.size(); }
+	size_t SourceTriangles() const { return sourceTriangles; }   // Of every member a proxy stands for
+	size_t ProxyTriangles() const { return proxyTriangles; }
+	double BuildMs() const { return buildMs; }
+	double ProxiesPerFrame() const { return frames ? (double)proxiesDrawn / frames : 0.0; }
+	double BodiesReplacedPerFrame() const { return frames ? (double)bodiesReplaced / frames : 0.0; }
+
+private:
+	// Merge mesh at every member of cluster into one mesh and weld it, Rossignac & Borrel vertex clustering
+	Mesh buildProxy(const HLODCluster& cluster, const std::vector<glm::vec3>& positions, const Mesh& mesh);
+
+	/*  HLOD data  */
+	std::vector<HLODCluster> clusters;
+	std::vector<Mesh> proxies;
+	size_t sourceTriangles, proxyTriangles;
+	double buildMs;
+	uint64_t frames, proxiesDrawn, bodiesReplaced;
+};
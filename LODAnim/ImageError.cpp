@@ -0,0 +1,174 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Image Error, how far a frame is from a reference render, and a per-frame log of it against triangle counts
+
+// Std. Includes
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <emmintrin.h>
+
+// custom Includes
+#include "ImageError.h"
+#include "Profiler.h"
+
+// SSIM window side, and its stabilising constants for 8-bit values
+static const int SSIM_BLOCK = 8;
+static const double SSIM_C1 = (0.01 * 255) * (0.01 * 255), SSIM_C2 = (0.03 * 255) * (0.03 * 255);
+
+static int horizontalSum(__m128i v)
+{
+	v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+	v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(v);
+}
+
+// Sum of squared R, G, B differences of count pixels, and the largest difference
+static uint64_t squaredError(const unsigned char* a, const unsigned char* b, size_t count, int& maxError)
+{
+	const __m128i colour = _mm_set1_epi32(0x00FFFFFF);
+	const __m128i zero = _mm_setzero_si128();
+	__m128i largest = zero;
+	uint64_t sum = 0;
+
+	// Four pixels a step, lanes flushed to 64 bits every 1024 steps before they can overflow
+	size_t i = 0;
+	while (i + 4 <= count) {
+		__m128i lanes = zero;
+		for (size_t steps = 0; steps < 1024 && i + 4 <= count; steps++, i += 4) {
+			const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i * 4));
+			const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i * 4));
+			const __m128i difference = _mm_and_si128(_mm_or_si128(_mm_subs_epu8(x, y), _mm_subs_epu8(y, x)), colour);
+			largest = _mm_max_epu8(largest, difference);
+
+			const __m128i low = _mm_unpacklo_epi8(difference, zero), high = _mm_unpackhi_epi8(difference, zero);
+			lanes = _mm_add_epi32(lanes, _mm_add_epi32(_mm_madd_epi16(low, low), _mm_madd_epi16(high, high)));
+		}
+		sum += (uint32_t)horizontalSum(lanes);
+	}
+
+	unsigned char bytes[16];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(bytes), largest);
+	maxError = *std::max_element(bytes, bytes + 16);
+
+	for (; i < count; i++) {
+		for (int c = 0; c < 3; c++) {
+			const int difference = std::abs((int)a[i * 4 + c] - (int)b[i * 4 + c]);
+			maxError = std::max(maxError, difference);
+			sum += difference * difference;
+		}
+	}
+	return sum;
+}
+
+// Rec. 601 luma of count pixels, (77 R + 150 G + 29 B) / 256
+static void luma(const unsigned char* rgba, uint8_t* out, size_t count)
+{
+	const __m128i byteMask = _mm_set1_epi32(0xFF);
+	const __m128i weightR = _mm_set1_epi16(77), weightG = _mm_set1_epi16(150), weightB = _mm_set1_epi16(29);
+
+	// Eight pixels a step, weighted sums fit unsigned 16 bits
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + i * 4));
+		const __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + i * 4 + 16));
+		const __m128i r = _mm_packs_epi32(_mm_and_si128(p0, byteMask), _mm_and_si128(p1, byteMask));
+		const __m128i g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 8), byteMask), _mm_and_si128(_mm_srli_epi32(p1, 8), byteMask));
+		const __m128i b = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 16), byteMask), _mm_and_si128(_mm_srli_epi32(p1, 16), byteMask));
+		const __m128i y = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(r, weightR), _mm_mullo_epi16(g, weightG)), _mm_mullo_epi16(b, weightB));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(_mm_srli_epi16(y, 8), _mm_setzero_si128()));
+	}
+	for (; i < count; i++)
+		out[i] = (uint8_t)((77 * rgba[i * 4] + 150 * rgba[i * 4 + 1] + 29 * rgba[i * 4 + 2]) >> 8);
+}
+
+// Mean SSIM of the whole 8x8 blocks, partial blocks at the right and top edges are left out
+static double meanSSIM(const uint8_t* x, const uint8_t* y, int width, int height)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const double n = SSIM_BLOCK * SSIM_BLOCK;
+	double total = 0.0;
+	int blocks = 0;
+
+	for (int by = 0; by + SSIM_BLOCK <= height; by += SSIM_BLOCK) {
+		for (int bx = 0; bx + SSIM_BLOCK <= width; bx += SSIM_BLOCK) {
+			__m128i sums = zero, xx = zero, yy = zero, xy = zero;
+			for (int row = 0; row < SSIM_BLOCK; row++) {
+				const size_t offset = (size_t)(by + row) * width + bx;
+				const __m128i x8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(x + offset));
+				const __m128i y8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(y + offset));
+
+				// Sums of x in the low half, y in the high half
+				sums = _mm_add_epi64(sums, _mm_sad_epu8(_mm_unpacklo_epi64(x8, y8), zero));
+
+				const __m128i x16 = _mm_unpacklo_epi8(x8, zero), y16 = _mm_unpacklo_epi8(y8, zero);
+				xx = _mm_add_epi32(xx, _mm_madd_epi16(x16, x16));
+				yy = _mm_add_epi32(yy, _mm_madd_epi16(y16, y16));
+				xy = _mm_add_epi32(xy, _mm_madd_epi16(x16, y16));
+			}
+
+			const double meanX = _mm_cvtsi128_si32(sums) / n;
+			const double meanY = _mm_cvtsi128_si32(_mm_srli_si128(sums, 8)) / n;
+			const double varianceX = horizontalSum(xx) / n - meanX * meanX;
+			const double varianceY = horizontalSum(yy) / n - meanY * meanY;
+			const double covariance = horizontalSum(xy) / n - meanX * meanY;
+
+			total += ((2.0 * meanX * meanY + SSIM_C1) * (2.0 * covariance + SSIM_C2))
+				/ ((meanX * meanX + meanY * meanY + SSIM_C1) * (varianceX + varianceY + SSIM_C2));
+			blocks++;
+		}
+	}
+	return blocks ? total / blocks : 1.0;
+}
+
+
+ImageError ImageComparer::Compare(const unsigned char* reference, const unsigned char* image, int width, int height)
+{
+	PROFILE_ZONE("Image Compare");
+	const size_t pixels = (size_t)width * height;
+	ImageError error;
+
+	const uint64_t squared = squaredError(reference, image, pixels, error.maxError);
+	error.mse = pixels ? (double)squared / (pixels * 3) : 0.0;
+	error.psnr = error.mse > 0.0 ? std::min(10.0 * std::log10(255.0 * 255.0 / error.mse), PSNR_IDENTICAL) : PSNR_IDENTICAL;
+
+	referenceLuma.resize(pixels);
+	imageLuma.resize(pixels);
+	if (pixels) {
+		luma(reference, &referenceLuma[0], pixels);
+		luma(image, &imageLuma[0], pixels);
+	}
+	error.ssim = pixels ? meanSSIM(&referenceLuma[0], &imageLuma[0], width, height) : 1.0;
+	return error;
+}
+
+
+LODErrorLog::LODErrorLog() :
+	frames(0), psnrSum(0.0), ssimSum(0.0), worstPSNR(PSNR_IDENTICAL), worstSSIM(1.0), worstMaxError(0), triangles(0), referenceTriangles(0)
+{
+}
+
+bool LODErrorLog::Open(const std::string& path)
+{
+	file.open(path.c_str(), std::ios::trunc);
+	if (!file) {
+		std::cout << "ERROR::LOD ERROR:: Could not write " << path << std::endl;
+		return false;
+	}
+	file << "time,triangles,reference_triangles,psnr,ssim,max_error\n";
+	return true;
+}
+
+void LODErrorLog::Frame(double time, uint64_t triangles, uint64_t referenceTriangles, const ImageError& error)
+{
+	file << time << "," << triangles << "," << referenceTriangles << "," << error.psnr << "," << error.ssim << "," << error.maxError << "\n";
+
+	frames++;
+	psnrSum += error.psnr;
+	ssimSum += error.ssim;
+	worstPSNR = std::min(worstPSNR, error.psnr);
+	worstSSIM = std::min(worstSSIM, error.ssim);
+	worstMaxError = std::max(worstMaxError, error.maxError);
+	this->triangles += triangles;
+	this->referenceTriangles += referenceTriangles;
+}
@@ -0,0 +1,65 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Image Error, how far a frame is from a reference render, and a per-frame log of it against triangle counts
+
+// Std. Includes
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+// Difference of one image from its reference
+struct ImageError {
+	double mse;        // Mean squared error over R, G and B
+	double psnr;       // dB, capped at PSNR_IDENTICAL when the images match
+	double ssim;       // Mean structural similarity of the 8x8 luma blocks, 1 when they match
+	int maxError;      // Largest difference of any channel, 0 - 255
+};
+
+const double PSNR_IDENTICAL = 100.0;
+
+// Compares RGBA8 images with SSE2 kernels, keeps its luma planes between calls
+class ImageComparer
+{
+public:
+	// Both images width x height, alpha is ignored
+	ImageError Compare(const unsigned char* reference, const unsigned char* image, int width, int height);
+
+private:
+	/*  Scratch data  */
+	std::vector<uint8_t> referenceLuma;
+	std::vector<uint8_t> imageLuma;
+};
+
+// Error of every frame next to what it cost, as CSV, with the run's totals for the report
+class LODErrorLog
+{
+public:
+	LODErrorLog();
+
+	// Start the CSV, false and an error if it can't be written
+	bool Open(const std::string& path);
+
+	// One frame: triangles drawn with LOD selection and with every body at LOD0
+	void Frame(double time, uint64_t triangles, uint64_t referenceTriangles, const ImageError& error);
+
+	int Frames() const { return frames; }
+	double MeanPSNR() const { return frames ? psnrSum / frames : PSNR_IDENTICAL; }
+	double MeanSSIM() const { return frames ? ssimSum / frames : 1.0; }
+	double WorstPSNR() const { return worstPSNR; }
+	double WorstSSIM() const { return worstSSIM; }
+	int WorstMaxError() const { return worstMaxError; }
+
+	// Share of the LOD0 triangles LOD selection drew
+	double TriangleRatio() const { return referenceTriangles ? (double)triangles / referenceTriangles : 1.0; }
+
+private:
+	/*  Log data  */
+	std::ofstream file;
+	int frames;
+	double psnrSum, ssimSum;
+	double worstPSNR, worstSSIM;
+	int worstMaxError;
+	uint64_t triangles, referenceTriangles;
+};
@@ -0,0 +1,158 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Image Writer, RGBA8 pixels to PNG or PPM files without any image library
+
+// Std. Includes
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+// custom Includes
+#include "ImageWriter.h"
+
+// Largest stored deflate block, and the most bytes Adler-32 can sum before its modulus overflows 32 bits
+static const size_t STORED_BLOCK = 65535;
+static const size_t ADLER_RUN = 5552;
+
+struct CrcTable {
+	uint32_t entries[256];
+
+	CrcTable() {
+		for (uint32_t n = 0; n < 256; n++) {
+			uint32_t c = n;
+			for (int k = 0; k < 8; k++)
+				c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+			entries[n] = c;
+		}
+	}
+};
+
+// CRC-32 of PNG chunks, encoder threads share the table
+static uint32_t crc32(const unsigned char* data, size_t size, uint32_t crc = 0)
+{
+	static const CrcTable crcTable;
+	const uint32_t* table = crcTable.entries;
+
+	crc = ~crc;
+	for (size_t i = 0; i < size; i++)
+		crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	return ~crc;
+}
+
+static void putBigEndian(std::vector<unsigned char>& out, uint32_t value)
+{
+	out.push_back((unsigned char)(value >> 24));
+	out.push_back((unsigned char)(value >> 16));
+	out.push_back((unsigned char)(value >> 8));
+	out.push_back((unsigned char)value);
+}
+
+// Length, type, data, CRC of type and data
+static void writeChunk(std::ofstream& file, const char* type, const std::vector<unsigned char>& data)
+{
+	std::vector<unsigned char> chunk;
+	putBigEndian(chunk, (uint32_t)data.size());
+	chunk.insert(chunk.end(), type, type + 4);
+	chunk.insert(chunk.end(), data.begin(), data.end());
+	putBigEndian(chunk, crc32(&chunk[4], chunk.size() - 4));
+	file.write(reinterpret_cast<const char*>(&chunk[0]), chunk.size());
+}
+
+static bool open(std::ofstream& file, const std::string& path)
+{
+	file.open(path.c_str(), std::ios::binary | std::ios::trunc);
+	if (!file)
+		std::cout << "ERROR::IMAGE WRITER:: Could not write " << path << std::endl;
+	return (bool)file;
+}
+
+
+bool WritePNG(const std::string& path, const unsigned char* rgba, int width, int height, bool flip)
+{
+	if (width <= 0 || height <= 0)
+		return false;
+	std::ofstream file;
+	if (!open(file, path))
+		return false;
+	static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+	// 8-bit RGBA, no interlacing
+	std::vector<unsigned char> header;
+	putBigEndian(header, (uint32_t)width);
+	putBigEndian(header, (uint32_t)height);
+	const unsigned char format[5] = { 8, 6, 0, 0, 0 };
+	header.insert(header.end(), format, format + 5);
+	writeChunk(file, "IHDR", header);
+
+	// Scanlines each led by filter type 0
+	const size_t stride = (size_t)width * 4;
+	std::vector<unsigned char> raw((stride + 1) * height);
+	for (int y = 0; y < height; y++) {
+		const unsigned char* row = rgba + stride * (flip ? height - 1 - y : y);
+		raw[(stride + 1) * y] = 0;
+		std::copy(row, row + stride, &raw[(stride + 1) * y + 1]);
+	}
+
+	// zlib stream of stored blocks, then the Adler-32 of the scanlines
+	std::vector<unsigned char> data;
+	data.reserve(raw.size() + raw.size() / STORED_BLOCK * 5 + 16);
+	data.push_back(0x78);
+	data.push_back(0x01);
+	uint32_t a = 1, b = 0;
+	for (size_t offset = 0; offset < raw.size(); offset += STORED_BLOCK) {
+		const size_t size = std::min(STORED_BLOCK, raw.size() - offset);
+		data.push_back(offset + size == raw.size() ? 1 : 0);
+		data.push_back((unsigned char)size);
+		data.push_back((unsigned char)(size >> 8));
+		data.push_back((unsigned char)~size);
+		data.push_back((unsigned char)(~size >> 8));
+		data.insert(data.end(), raw.begin() + offset, raw.begin() + offset + size);
+
+		for (size_t run = offset; run < offset + size; run += ADLER_RUN) {
+			const size_t end = std::min(run + ADLER_RUN, offset + size);
+			for (size_t i = run; i < end; i++) {
+				a += raw[i];
+				b += a;
+			}
+			a %= 65521;
+			b %= 65521;
+		}
+	}
+	putBigEndian(data, (b << 16) | a);
+	writeChunk(file, "IDAT", data);
+	writeChunk(file, "IEND", std::vector<unsigned char>());
+
+	if (!file) {
+		std::cout << "ERROR::IMAGE WRITER:: Could not write " << path << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool WritePPM(const std::string& path, const unsigned char* rgba, int width, int height, bool flip)
+{
+	std::ofstream file;
+	if (!open(file, path))
+		return false;
+	file << "P6\n" << width << " " << height << "\n255\n";
+
+	std::vector<unsigned char> row((size_t)width * 3);
+	for (int y = 0; y < height; y++) {
+		const unsigned char* source = rgba + (size_t)width * 4 * (flip ? height - 1 - y : y);
+		for (int x = 0; x < width; x++) {
+			row[x * 3] = source[x * 4];
+			row[x * 3 + 1] = source[x * 4 + 1];
+			row[x * 3 + 2] = source[x * 4 + 2];
+		}
+		file.write(reinterpret_cast<const char*>(&row[0]), row.size());
+	}
+
+	if (!file) {
+		std::cout << "ERROR::IMAGE WRITER:: Could not write " << path << std::endl;
+		return false;
+	}
+	return true;
+}
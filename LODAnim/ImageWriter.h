@@ -0,0 +1,16 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Image Writer, RGBA8 pixels to PNG or PPM files without any image library
+
+// Std. Includes
+#include <string>
+
+// Rows of GL readbacks are bottom first, flip writes them top first like every image viewer expects.
+// Both return false and print an error if the file can't be written
+
+// RGBA PNG, deflate in stored blocks: nothing to compress with, so fast but as large as the pixels
+bool WritePNG(const std::string& path, const unsigned char* rgba, int width, int height, bool flip);
+
+// Binary PPM (P6), alpha dropped. Raw pixels any tool can read
+bool WritePPM(const std::string& path, const unsigned char* rgba, int width, int height, bool flip);
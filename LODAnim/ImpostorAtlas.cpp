@@ -0,0 +1,217 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Impostor Atlas, a mesh baked from an octahedral grid of view directions, for a last level past every mesh
+
+// Std. Includes
+#include <iostream>
+#include <cmath>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+// GL Includes
+#include <glm/gtc/matrix_transform.hpp>
+
+// custom Includes
+#include "ImpostorAtlas.h"
+#include "ImageWriter.h"
+#include "GLDispatch.h"
+#include "UniformRing.h"
+#include "RenderBackend.h"
+#include "FrameStats.h"
+#include "Profiler.h"
+#include "ShaderCache.h"
+#include "stb_image.h"
+
+// Pixels per atlas side
+static const int ATLAS_SIZE = IMPOSTOR_FRAMES * IMPOSTOR_CELL;
+
+// Up vector of a view's lookAt, bakeAxes in uber.glsl picks the same
+static glm::vec3 viewUp(glm::vec3 direction)
+{
+	return std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+}
+
+
+ImpostorAtlas::ImpostorAtlas() :
+	bakeMs(0.0)
+{
+	textures[0] = textures[1] = 0;
+}
+
+ImpostorAtlas::~ImpostorAtlas()
+{
+	if (textures[0])
+		glDeleteTextures(2, textures);
+}
+
+glm::vec3 ImpostorAtlas::ViewDirection(int x, int y)
+{
+	// Octahedral decode of the cell centre, the lower hemisphere is folded over the corners
+	const glm::vec2 p((x + 0.5f) / IMPOSTOR_FRAMES * 2.0f - 1.0f, (y + 0.5f) / IMPOSTOR_FRAMES * 2.0f - 1.0f);
+	glm::vec3 n(p.x, p.y, 1.0f - std::abs(p.x) - std::abs(p.y));
+	if (n.z < 0.0f) {
+		const float fx = (1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+		const float fy = (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+		n.x = fx;
+		n.y = fy;
+	}
+	return glm::normalize(n);
+}
+
+std::string ImpostorAtlas::CachePath(const std::string& modelPath, const Mesh& mesh, float radius, const std::string& bakeSource)
+{
+	// Field by field, Vertex may be padded
+	uint64_t hash = ShaderCache::Hash(bakeSource.data(), bakeSource.size());
+	for (const Vertex& vertex : mesh.vertices) {
+		hash = ShaderCache::Hash(&vertex.Position, sizeof(glm::vec3), hash);
+		hash = ShaderCache::Hash(&vertex.Normal, sizeof(glm::vec3), hash);
+	}
+	if (!mesh.indices.empty())
+		hash = ShaderCache::Hash(&mesh.indices[0], mesh.indices.size() * sizeof(GLuint), hash);
+	const float constants[] = { (float)IMPOSTOR_FRAMES, IMPOSTOR_MARGIN, (float)IMPOSTOR_CELL, radius };
+	hash = ShaderCache::Hash(constants, sizeof(constants), hash);
+
+	std::ostringstream name;
+	name << modelPath << "." << std::hex << std::setw(16) << std::setfill('0') << hash << ".impostor.png";
+	return name.str();
+}
+
+bool ImpostorAtlas::Load(const std::string& path)
+{
+	// Written top row first, flipped back to GL's bottom first
+	int width, height, channels;
+	stbi_set_flip_vertically_on_load(1);
+	unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+	stbi_set_flip_vertically_on_load(0);
+	if (!pixels)
+		return false;
+	const bool fits = width == ATLAS_SIZE && height == ATLAS_SIZE * 2;
+	if (fits) {
+		const size_t bytes = (size_t)ATLAS_SIZE * ATLAS_SIZE * 4;
+		albedo.assign(pixels, pixels + bytes);
+		normalDepth.assign(pixels + bytes, pixels + bytes * 2);
+	}
+	else
+		std::cout << "ERROR::IMPOSTOR ATLAS:: " << path << " is " << width << "x" << height << ", baking again" << std::endl;
+	stbi_image_free(pixels);
+	return fits;
+}
+
+void ImpostorAtlas::Bake(const Mesh& mesh, Shader& program, float radius)
+{
+	PROFILE_ZONE("Impostor Bake");
+	const uint64_t start = Profiler::Now();
+
+	// Put back afterwards: the scene's framebuffer (offscreen when headless), viewport and blending
+	GLint previousFramebuffer, viewport[4];
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	const bool blend = glIsEnabled(GL_BLEND) == GL_TRUE;
+
+	// Both maps and a depth buffer, one view per cell
+	GLuint framebuffer, renderbuffers[3];
+	glGenFramebuffers(1, &framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glGenRenderbuffers(3, renderbuffers);
+	const GLenum formats[] = { GL_RGBA8, GL_RGBA8, GL_DEPTH_COMPONENT24 };
+	const GLenum attachments[] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_DEPTH_ATTACHMENT };
+	for (int i = 0; i < 3; i++) {
+		glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[i]);
+		glRenderbufferStorage(GL_RENDERBUFFER, formats[i], ATLAS_SIZE, ATLAS_SIZE);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachments[i], GL_RENDERBUFFER, renderbuffers[i]);
+	}
+	glDrawBuffers(2, attachments);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		std::cout << "ERROR::IMPOSTOR ATLAS:: Bake framebuffer is not complete" << std::endl;
+
+	// A null or recording dispatch mustn't swallow the bake or put it in the stream. Blending would scale the
+	// normals by the depth in their alpha
+	GLDispatch& gl = GLDispatch::Shared();
+	const DispatchMode mode = gl.Mode();
+	gl.SetMode(DISPATCH_DIRECT);
+	gl.Invalidate();
+	gl.Disable(GL_BLEND);
+	glEnable(GL_SCISSOR_TEST);
+	gl.ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+	// Orthographic views from 2 margins out, depth runs from a margin in front of the centre to one behind
+	const float extent = radius * IMPOSTOR_MARGIN;
+	FrameUniforms frame;
+	frame.projection = glm::ortho(-extent, extent, -extent, extent, extent, 3.0f * extent);
+	frame.lightPos = frame.lightColour = frame.viewPos = glm::vec4(0.0f);
+
+	// Normals come out in model space
+	ObjectUniforms object;
+	object.model = glm::mat4();
+	object.colour = glm::vec4(1.0f);
+	FillNormalMatrices(&object, 1);
+
+	program.Use();
+	for (int y = 0; y < IMPOSTOR_FRAMES; y++) {
+		for (int x = 0; x < IMPOSTOR_FRAMES; x++) {
+			glViewport(x * IMPOSTOR_CELL, y * IMPOSTOR_CELL, IMPOSTOR_CELL, IMPOSTOR_CELL);
+			glScissor(x * IMPOSTOR_CELL, y * IMPOSTOR_CELL, IMPOSTOR_CELL, IMPOSTOR_CELL);
+			gl.Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+			const glm::vec3 direction = ViewDirection(x, y);
+			frame.view = glm::lookAt(direction * 2.0f * extent, glm::vec3(0.0f), viewUp(direction));
+			gl.UniformBlock(FRAME_BLOCK_BINDING, &frame, sizeof(FrameUniforms));
+			gl.UniformBlock(OBJECT_BLOCK_BINDING, &object, sizeof(ObjectUniforms));
+			mesh.Draw();
+		}
+	}
+
+	// Read both maps back for the cache
+	albedo.resize((size_t)ATLAS_SIZE * ATLAS_SIZE * 4);
+	normalDepth.resize(albedo.size());
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadBuffer(GL_COLOR_ATTACHMENT0);
+	glReadPixels(0, 0, ATLAS_SIZE, ATLAS_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, &albedo[0]);
+	glReadBuffer(GL_COLOR_ATTACHMENT1);
+	glReadPixels(0, 0, ATLAS_SIZE, ATLAS_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, &normalDepth[0]);
+
+	glDisable(GL_SCISSOR_TEST);
+	if (blend)
+		gl.Enable(GL_BLEND);
+	gl.SetMode(mode);
+	gl.Invalidate();
+	glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+	glDeleteRenderbuffers(3, renderbuffers);
+	glDeleteFramebuffers(1, &framebuffer);
+
+	// Not part of the first frame's counters
+	FrameStats::Shared().Discard();
+	bakeMs = (Profiler::Now() - start) / 1e6;
+}
+
+bool ImpostorAtlas::Write(const std::string& path) const
+{
+	std::vector<unsigned char> stacked(albedo);
+	stacked.insert(stacked.end(), normalDepth.begin(), normalDepth.end());
+	return WritePNG(path, &stacked[0], ATLAS_SIZE, ATLAS_SIZE * 2, true);
+}
+
+void ImpostorAtlas::Bind()
+{
+	if (!textures[0])
+		glGenTextures(2, textures);
+
+	const std::vector<unsigned char>* maps[] = { &albedo, &normalDepth };
+	const GLuint units[] = { IMPOSTOR_ALBEDO_UNIT, IMPOSTOR_NORMAL_DEPTH_UNIT };
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (int i = 0; i < 2; i++) {
+		glActiveTexture(GL_TEXTURE0 + units[i]);
+		glBindTexture(GL_TEXTURE_2D, textures[i]);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, ATLAS_SIZE, ATLAS_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, &(*maps[i])[0]);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	}
+
+	// Back to the unit text uses, the dispatch's shadow state no longer matches
+	glActiveTexture(GL_TEXTURE0);
+	GLDispatch::Shared().Invalidate();
+}
@@ -0,0 +1,65 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Impostor Atlas, a mesh baked from an octahedral grid of view directions, for a last level past every mesh
+
+// Std. Includes
+#include <string>
+#include <vector>
+
+// GL Includes
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+// custom Includes
+#include "Mesh.h"
+#include "Shader.h"
+
+// Views per atlas side and their margin in radii, match IMPOSTOR_FRAMES and IMPOSTOR_MARGIN in uber.glsl
+const int IMPOSTOR_FRAMES = 8;
+const float IMPOSTOR_MARGIN = 1.1f;
+
+// Pixels per view side, far bodies never cover more
+const int IMPOSTOR_CELL = 64;
+
+// Texture units the atlas stays bound to, text only uses unit 0
+const GLuint IMPOSTOR_ALBEDO_UNIT = 1, IMPOSTOR_NORMAL_DEPTH_UNIT = 2;
+
+// Two RGBA8 maps of IMPOSTOR_FRAMES x IMPOSTOR_FRAMES views. Albedo holds colour and coverage, the other the
+// model-space normal and depth through the view's range. View (x, y) looks from the octahedral direction at the
+// centre of cell (x, y), as the OCTAHEDRAL_IMPOSTOR program expects
+class ImpostorAtlas
+{
+public:
+	ImpostorAtlas();
+	~ImpostorAtlas();
+
+	// Where the atlas of mesh baked by the program with bakeSource is cached, next to the model. Named by a hash
+	// of the mesh, radius, bake constants and source, so a change to any of them bakes a new atlas
+	static std::string CachePath(const std::string& modelPath, const Mesh& mesh, float radius, const std::string& bakeSource);
+
+	// Read a cached atlas, false if there is none or it was baked at another size
+	bool Load(const std::string& path);
+
+	// Render mesh from every view, program is an IMPOSTOR_BAKE variant and radius bounds the mesh. Needs a current
+	// GL context. Goes straight to GL whatever the dispatch mode, and its draws aren't counted in any frame
+	void Bake(const Mesh& mesh, Shader& program, float radius);
+
+	// Both maps stacked in one PNG, albedo below, false and an error if it can't be written
+	bool Write(const std::string& path) const;
+
+	// Upload both maps and leave them bound to IMPOSTOR_ALBEDO_UNIT and IMPOSTOR_NORMAL_DEPTH_UNIT
+	void Bind();
+
+	// Milliseconds the last Bake took
+	double BakeMs() const { return bakeMs; }
+
+	// Unit direction from the centre to the eye of view (x, y)
+	static glm::vec3 ViewDirection(int x, int y);
+
+private:
+	/*  Atlas data  */
+	std::vector<unsigned char> albedo, normalDepth;    // Bottom row first
+	GLuint textures[2];
+	double bakeMs;
+};
@@ -4,8 +4,15 @@
 
 // Std. Includes
 #include <iostream>
-#include <Windows.h>
-#include <ctime>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <thread>
 
 // GL Includes
 #define GLEW_STATIC
@@ -14,7 +21,6 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
-#include <GL/GLU.h>
 
 // freetype Includes
 #include <ft2build.h>
@@ -22,20 +28,87 @@
 
 // custom Includes
 #include "Model.h"
+#include "RenderBackend.h"
+#include "GLBackend.h"
+#include "SoftwareBackend.h"
 #include "Shader.h"
 #include "stb_image.h"
 #include "Camera.h"
-
-// Height, Width and FOV constraints
+#include "GpuProfiler.h"
+#include "FrameStats.h"
+#include "RenderContext.h"
+#include "PerfReport.h"
+#include "Clock.h"
+#include "Timeline.h"
+#include "LevelOfDetail.h"
+#include "Session.h"
+#include "GLDispatch.h"
+#include "FrameCapture.h"
+#include "ImageError.h"
+#include "LODTable.h"
+#include "LODTuner.h"
+#include "ImpostorAtlas.h"
+#include "HLOD.h"
+#include "TextLayout.h"
+#include "ShaderManager.h"
+#include "ShaderVariants.h"
+#include "Profiler.h"
+
+// Height, Width and FOV constraints. Width and Height are the HUD layout, the scene renders at any resolution
 const GLuint WIDTH = 1920, HEIGHT = 1080, FOV = 50;
 
-// Character struct for Text Rendering
-struct Character {
-	GLuint TextureID;   // ID handle of the glyph texture
-	glm::ivec2 Size;    // Size of glyph
-	glm::ivec2 Bearing;  // Offset from baseline to left/top of glyph
-	GLuint Advance;    // Horizontal offset to advance to next glyph
+// Command line options, a benchmark runs for a frame or time budget and writes a report
+struct RunOptions {
+	ContextOptions context;
+	int frames;           // Stop after this many frames, 0 for no limit
+	double seconds;       // Stop after this much wall time, 0 for no limit
+	ClockMode clock;      // Real-time for viewing, a fixed step for reproducible runs
+	double step;          // Seconds per frame of the fixed step clocks
+	std::string report;   // JSON report path, "-" for standard output
+	std::string timeline; // Scenario file, what draws when and where the camera is
+	std::string record;   // Session log to record key presses and frame times into
+	std::string replay;   // Session log to draw the frames of instead of taking input
+	std::string backend;  // "gl", or "software" to rasterize on the CPU without a GL context
+	bool glNull;          // Record the GL calls of each frame without executing them, times the engine alone
+	std::string glRecord; // Command stream to write every frame's GL calls into
+	std::string glReplay; // Command stream to execute instead of drawing the scene, times the driver alone
+	bool sortDraws;       // GL draws in sort key order, or in the order the scene submits them
+	std::string capture;  // Directory to write every frame into, without the HUD
+	CaptureFormat captureFormat;
+	std::string lodError; // CSV of every frame's error against an LOD0 render, and its triangle counts
+	std::string lodTable; // Per-asset LOD distances, the bodies use the "body" tables
+	std::string distances;// Normal mode's distances instead of the table's
+	std::string tuneLOD;  // Write a tuned LOD table here and exit
+	double tunePSNR;      // Error the tuned normal table allows, exaggerated allows TUNE_EXAGGERATION dB more
+	bool octahedral;      // Draw the last body level from a baked octahedral atlas instead of ray-casting spheres
+	bool bakeImpostors;   // Bake the atlas again even if a cached one exists
+	bool hlod;            // Draw far clusters of a static field as one merged proxy each
+};
+
+// Scene sets a timeline can show and hide
+struct Scene {
+	bool title;          // Title text
+	bool orbits;         // Five orbiting bodies, their orbit paths and the sun
+	bool hud;            // Controls, draw statistics and GPU pass times
+	bool showcase;       // Row of every LOD level side by side
+	bool farRow;         // Row of every LOD level far from the camera
+	bool field;          // Generated field of orbiting or static bodies
+	bool whitePalette;   // Orbiting bodies white instead of coloured by LOD level
 };
+
+// Names a timeline shows and hides the scene sets by
+const vector<string> sceneSets = { "title", "orbits", "hud", "showcase", "far-row", "field" };
+
+bool& sceneSet(Scene& scene, const string& name) {
+	if (name == "title") return scene.title;
+	if (name == "orbits") return scene.orbits;
+	if (name == "hud") return scene.hud;
+	if (name == "showcase") return scene.showcase;
+	if (name == "far-row") return scene.farRow;
+	return scene.field;
+}
+
+// Glyphs for Text Rendering
 std::map<GLchar, Character> Characters;
 GLuint VAO, VBO;
 
@@ -58,18 +131,43 @@ glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 32.0f, 11.0f), // position
 	glm::vec3(0.0f, 0.0f, 0.0f), // point to look at
 	glm::vec3(0.0f, 1.0f, 47.0f)); // up direction
 
-// Model Mode: LOD, LOD0, Wireframe LOD, Wireframe LOD0, Exaggerated LOD, LOD0 -> LOD4
+// Model Mode: LOD, Exaggerated LOD, LOD0 -> LOD4, Impostor
 int mode = 0, camPos = 0;
 
-// Time
+// LOD distances of the bodies in normal and exaggerated mode, replaced by the LOD table's. --distances replaces
+// normal mode's to compare tables. Bodies beyond the last are impostors
+float LODDistances[] = { 35.0f, 55.0f, 65.0f, 75.0f, 100.0f };
+float ExaggeratedDistances[] = { 30.0f, 37.0f, 44.0f, 51.0f, 58.0f };
+
+// Name of the bodies in LOD tables, and how much more error the tuned exaggerated table allows
+const char* BODY_ASSET = "body";
+const double TUNE_EXAGGERATION = 10.0;
+
+// Time, every animated value reads animationClock. currentTime is its time less the title lead-in
+Clock animationClock;
 float currentTime = 0;
 
-// Polygon Count
-int polyCount[] = { 0, 0 };
+// Key presses and frame times of this run, when --record is given
+SessionRecorder recorder;
+
+// Export the per-frame draw statistics
+bool statsRequested = false;
 
 // Toggle Wireframe
 bool wireframe = false;
 
+// Store normals as 10:10:10:2 in the geometry arena, 16 byte vertices instead of 24
+const bool PACKED_VERTICES = true;
+
+// Toggle CPU zone timings on the HUD, request a Chrome trace of the recent frames
+bool showProfiler = false, traceRequested = false;
+
+// Toggle per-vertex normal matrix (old shader path) to compare GPU time against the CPU normal matrix
+bool perVertexNormals = false;
+
+// Last body level from the baked LOD0 atlas, the path for assets that aren't spheres
+bool octahedralImpostors = false;
+
 // Set Camera Transformation
 void setCamera() {
 	view = glm::lookAt(cameraPosition, // position
@@ -77,6 +175,14 @@ void setCamera() {
 		glm::vec3(0.0f, 1.0f, 37.0f)); // up direction
 }
 
+// Move Camera to any position, the LOD reference moves with it
+void cameraMoveTo(glm::vec3 position, glm::vec3 target) {
+	cameraTarget = target;
+	cameraPosition = position;
+	LODPosition = cameraPosition;
+	setCamera();
+}
+
 // Move Camera to Position 1
 void cameraMovePos1() {
 	cameraTarget = glm::vec3(0.0f, 0.0f, 0.0f);
@@ -101,15 +207,6 @@ void cameraMovePos3() {
 	setCamera();
 }
 
-// Calculate the Euclidean Distance between 2 Positions
-float EuclideanDistance(glm::vec3 modelLoc, glm::vec3 referenceLoc) {
-	float sum = 0;
-	for (int i = 0; i < 3; i++) {
-		sum += pow((referenceLoc[i] - modelLoc[i]), 2);
-	}
-	return sqrt(sum);
-}
-
 // Get Mode Type
 string getMode() {
 	switch (mode) {
@@ -127,229 +224,274 @@ string getMode() {
 		return "(Left | Right Arrows) LOD All Level L3";
 	case 6:
 		return "(Left | Right Arrows) LOD All Level L4";
+	case 7:
+		return "(Left | Right Arrows) LOD All Level L5 Impostor";
 	default:
 		return "(Left | Right Arrows) Mode out of range";			
 	}
 }
 
-// Check the LOD
-int CheckLevel(glm::vec3 objectT, float Distances[]) {
-	float distance = EuclideanDistance(objectT, LODPosition);
-
-	int level;
-	if (distance < Distances[0]) {
-		level = 0;
-	}
-	else if (distance < Distances[1]) {
-		level = 1;
-	}
-	else if (distance < Distances[2]) {
-		level = 2;
-	}
-	else if (distance < Distances[3]) {
-		level = 3;
-	}
-	else if(distance < INFINITE){
-		level = 4;
-	}
-	return level;
+// Features shared by every object program
+unsigned objectVariant() {
+	return !GeometryArena::CPUOnly() && GeometryArena::Shared().Packed() ? VARIANT_PACKED : 0;
 }
 
-// Get polygon count
-void polygonCount(int level) {
-	if (polyCount[1] == 5) {
-		polyCount[0] = 0;
-		polyCount[1] = 0;
-	}
-	// Check levels, state polygon count based on current meshes
-	switch (level) {
-	case 0:
-		polyCount[0] += 16128;
-		break;
-	case 1:
-		polyCount[0] += 3968;
-		break;
-	case 2:
-		polyCount[0] += 960;
-		break;
-	case 3:
-		polyCount[0] += 224;
-		break;
-	case 4:
-		polyCount[0] += 48;
-	}
-	polyCount[1] += 1;
+// Cheapest program that still looks right for a body at this LOD level, wires drawn over the solid mesh
+unsigned bodyVariant(int level, bool wires) {
+	unsigned variant = objectVariant() | VARIANT_LIT;
+
+	// Impostors have no edges to draw and work out their own normals, far enough away to skip the highlight
+	if (level == IMPOSTOR_LEVEL)
+		return variant | (octahedralImpostors ? VARIANT_OCTAHEDRAL : VARIANT_IMPOSTOR);
+
+	// Edges replace the highlight in wireframe mode, which is only a few pixels wide at LOD3 / LOD4 distances anyway
+	if (wires)
+		variant |= VARIANT_WIREFRAME;
+	else if (level <= 2)
+		variant |= VARIANT_SPECULAR;
+
+	// Bodies only rotate and translate, unless timing the old per-vertex path
+	variant |= perVertexNormals ? VARIANT_PER_VERTEX_NORMALS : VARIANT_RIGID;
+	return variant;
 }
 
-// Draw Models Orbiting & Path
-void Orbit(vector<Model> & planets, Model ring, Shader shaderProgram, float orbitRadius, float orbitSpeed, float rotationSpeed, vector<glm::vec3> Colour, glm::vec3 rotationVector) {	
-	// LOD Distances
-	float ExaggeratedDistances[] = { 30.0f, 37.0f, 44.0f, 51.0f };
-	float Distances[] = { 35.0f, 55.0f, 65.0f, 75.0f };
+// Baking an impostor atlas: unshaded albedo, model-space normals and depth
+unsigned bakeVariant() {
+	return objectVariant() | VARIANT_LIT | VARIANT_RIGID | VARIANT_IMPOSTOR_BAKE;
+}
 
-	// LOD level
-	int level;
+// Orbit paths, lit without specular, all drawn in one instanced call
+unsigned ringVariant() {
+	return objectVariant() | VARIANT_LIT | VARIANT_INSTANCED | (perVertexNormals ? VARIANT_PER_VERTEX_NORMALS : 0);
+}
 
-	// Set Orbit Translation Vector
-	glm::vec3 objectT = { (sin((currentTime + 20.0f) / orbitSpeed) * orbitRadius), (cos((currentTime + 20.0f) / orbitSpeed) * orbitRadius), 0.0f };
+// Distance beyond which a whole static field cluster is its HLOD proxy, negative in the modes that fix the level
+float hlodDistance() {
+	// Proxies are merged from LOD4, so a cluster can only be one once every member would be LOD4 or coarser
+	switch (mode) {
+		case 0:
+			return LODDistances[3];
+		case 1:
+			return ExaggeratedDistances[3];
+		default:
+			return -1.0f;
+	}
+}
 
+// LOD level of a body at objectT in the current mode
+int selectLevel(glm::vec3 objectT) {
 	// Check Model Detail Level base on Mode
 	switch (mode) {
 		case 0:
-			level = CheckLevel(objectT, Distances);
-			break;
+			return CheckLevel(objectT, LODPosition, LODDistances);
 		case 1:
-			level = CheckLevel(objectT, ExaggeratedDistances);
-			break;
+			return CheckLevel(objectT, LODPosition, ExaggeratedDistances);
 		case 2:
-			level = 0;
-			break;
+			return 0;
 		case 3:
-			level = 1;
-			break;
+			return 1;
 		case 4:
-			level = 2;
-			break;
+			return 2;
 		case 5:
-			level = 3;
-			break;
+			return 3;
 		case 6:
-			level = 4;
-			break;
+			return 4;
+		case 7:
+			return IMPOSTOR_LEVEL;
 		default:
-			level = 4;
+			return 4;
+	}
+}
+
+// Draw Models Orbiting & Path
+void Orbit(vector<Model> & planets, Model& ring, RenderBackend& backend, vector<ObjectUniforms>& rings, float orbitRadius, float orbitSpeed, float rotationSpeed, vector<glm::vec3> Colour, glm::vec3 rotationVector) {	
+	// Set Orbit Translation Vector
+	glm::vec3 objectT = OrbitPosition(currentTime + 20.0f, orbitRadius, orbitSpeed);
+
+	// LOD level
+	int level;
+	{
+		PROFILE_ZONE("LOD Selection");
+		level = selectLevel(objectT);
 	}
-	polygonCount(level);
 
 	// Apply Transformation to Current Model
-	planets[level].transformR(shaderProgram, objectT, rotationVector, rotationSpeed, 1);
+	{
+		PROFILE_ZONE("Orbit Update");
+		planets[level].transformR(objectT, rotationVector, rotationSpeed, 1, (float)animationClock.Time());
 
-	// Change Colour of Model
-	planets[level].changeColour(shaderProgram, Colour[level]);
+		// Change Colour of Model
+		planets[level].changeColour(Colour[level]);
+	}
 
-	// Draw Model
-	planets[level].Draw(shaderProgram);
+	// Draw Model, wireframe mode picks the edge overlay variant of the same mesh
+	planets[level].Draw(backend, bodyVariant(level, wireframe), level);
 
-	// Apply Transformations to Orbit Path Model
-	ring.rotateS(shaderProgram, glm::vec3(1.0f, 0.0f, 0.0f), glm::radians(90.0f), glm::vec3(orbitRadius / 2.87f, 1.0f, orbitRadius / 2.87f));
+	// Apply Transformations to Orbit Path Model, scaled unevenly so it needs the full normal matrix
+	PROFILE_ZONE("Orbit Update");
+	ring.rotateS(glm::vec3(1.0f, 0.0f, 0.0f), glm::radians(90.0f), glm::vec3(orbitRadius / 2.87f, 1.0f, orbitRadius / 2.87f));
 
 	// Change Colour of Orbit Path Model
-	ring.changeColour(shaderProgram, glm::vec3(0.0f, 0.0f, 1.0f));
+	ring.changeColour(glm::vec3(0.0f, 0.0f, 1.0f));
 
-	// Draw Orbit Path Model
-	ring.Draw(shaderProgram);
+	// Queue Orbit Path Model, every ring is drawn in one instanced call by drawRings
+	rings.push_back(ring.Object());
 }
 
-// Setup Lighting Shader
-void setupLightSource(Shader shaderProgram) {
-	shaderProgram.Use(); // Activate Shader Program
-
-	// Get Uniform Locations from shaders
-	GLint objectColorLoc = glGetUniformLocation(shaderProgram.Program, "myColour");
-	GLint lightColorLoc = glGetUniformLocation(shaderProgram.Program, "lightColour");
-	GLint lightPosLoc = glGetUniformLocation(shaderProgram.Program, "lightPos");
-	GLint viewPosLoc = glGetUniformLocation(shaderProgram.Program, "viewPos");
-
-	// Define Shader Attributes
-	glUniform3f(objectColorLoc, 1.0f, 0.9f, 0.8f);
-	glUniform3f(lightColorLoc, 1.0f, 0.9f, 0.8f);
-	glUniform3f(lightPosLoc, lightPos.x, lightPos.y, lightPos.z);
-	glUniform3f(viewPosLoc, 0.0f, 0.0f, 0.0f);	
+// Draw all Orbit Paths queued this frame
+void drawRings(Model& ring, RenderBackend& backend, vector<ObjectUniforms>& rings) {
+	backend.BeginPass("Rings");
+	ring.DrawInstanced(backend, ringVariant(), rings);
+	backend.EndPass();
+	rings.clear();
 }
 
-// Draw Light Source
-void drawSun(Shader& shaderProgram, Model& sunModel, float modelSize) {
-	shaderProgram.Use(); // Activate Shader Program
-
-	glm::mat4 model; // Create Model Transformation Matrix	
-
-	// Translate Model to 'light position'
-	model = glm::translate(model, lightPos);
-
-	// Scale model to size
-	model = glm::scale(model, glm::vec3(modelSize));
-
-	// Send matrix to shaders
-	glUniformMatrix4fv(glGetUniformLocation(shaderProgram.Program, "model"), 1, GL_FALSE, glm::value_ptr(model));
+// One body of a generated field, orbiting the sun like the five showcase bodies or held at its phase
+struct FieldBody {
+	float radius;
+	float speed;     // Seconds per radian of orbit
+	float phase;
+	float height;
+	float spin;      // Degrees per second about its own axis
+};
 
-	// Draw Model
-	sunModel.Draw(shaderProgram);
+// Lay out count bodies, the same seed gives the same field on every machine
+vector<FieldBody> generateField(int count, unsigned seed) {
+	// Raw 32-bit draws scaled by hand, std distributions differ between standard libraries
+	std::mt19937 random(seed);
+	auto uniform = [&random](float low, float high) { return low + (high - low) * (float)(random() / 4294967296.0); };
+
+	vector<FieldBody> field(count);
+	for (FieldBody& body : field) {
+		body.radius = uniform(8.0f, 200.0f);
+		body.speed = body.radius * uniform(0.3f, 0.7f); // Outer bodies orbit slower, like the showcase ones
+		body.phase = uniform(0.0f, 6.2832f);
+		body.height = uniform(-4.0f, 4.0f);
+		body.spin = uniform(20.0f, 150.0f);
+	}
+	return field;
 }
 
-// Pass Projection & View Matrices to Shader Programs
-void passMatrixToShader(Shader shaderProgram, glm::mat4 projection, glm::mat4 view) {
-	// Send view & projection location to shader
-	glUniformMatrix4fv(glGetUniformLocation(shaderProgram.Program, "view"), 1, GL_FALSE, glm::value_ptr(view));
-	glUniformMatrix4fv(glGetUniformLocation(shaderProgram.Program, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+// Where a field body is at time. A static field holds each body at its phase angle, all the way round the sun
+glm::vec3 fieldPosition(const FieldBody& body, float time, bool orbiting) {
+	return OrbitPosition(orbiting ? time + body.phase : body.phase * body.speed, body.radius, body.speed, body.height);
 }
 
-int main()
-{
-/// CLOCK -------------------------------------------------------------------------------------------------
-/// -------------------------------------------------------------------------------------------------------
-/// -------------------------------------------------------------------------------------------------------
-	std::clock_t start;
-	double duration;
-	start = std::clock();
+// Draw the field, bodies grouped by LOD level into instanced draws of up to MAX_INSTANCES. Far bodies are one
+// instanced draw of impostor quads. With the clusters of a static field, each cluster far enough away is one
+// draw of its proxy and its bodies are never visited
+void drawField(vector<FieldBody>& field, bool orbiting, HLOD* hlod, vector<Model>& planets, RenderBackend& backend, vector<glm::vec3>& Colour, vector<ObjectUniforms> (&levels)[LOD_LEVELS]) {
+	static vector<int> nearBodies;
+	static vector<const Mesh*> proxies;
+	nearBodies.clear();
+	proxies.clear();
+
+	const float distance = hlodDistance();
+	const bool clustered = hlod && distance >= 0.0f;
+	if (clustered) {
+		PROFILE_ZONE("HLOD Selection");
+		hlod->Select(LODPosition, distance, nearBodies, proxies);
+	}
 
+	{
+		PROFILE_ZONE("Field Update");
+		const float time = (float)animationClock.Time();
+		const size_t count = clustered ? nearBodies.size() : field.size();
+		ObjectUniforms object;
+		for (size_t i = 0; i < count; i++) {
+			const FieldBody& body = field[clustered ? nearBodies[i] : i];
+			glm::vec3 objectT = fieldPosition(body, currentTime, orbiting);
+			int level = selectLevel(objectT);
+
+			object.model = glm::rotate(glm::translate(glm::mat4(), objectT), time * glm::radians(body.spin), glm::vec3(0.0f, 0.0f, 1.0f));
+			object.colour = glm::vec4(Colour[level], 1.0f);
+			levels[level].push_back(object);
+		}
+	}
 
-/// OPENGL ------------------------------------------------------------------------------------------------
-/// -------------------------------------------------------------------------------------------------------
-/// -------------------------------------------------------------------------------------------------------
-	// Init GLFW
-	glfwInit();
+	for (int level = 0; level < LOD_LEVELS; level++) {
+		planets[level].DrawInstanced(backend, bodyVariant(level, wireframe), levels[level], level);
+		levels[level].clear();
+	}
 
-	// Set all the required options for GLFW
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-	glfwWindowHint(GLFW_RESIZABLE, GL_FALSE);
-	glfwWindowHint(GLFW_SAMPLES, 4);
+	// Proxies are already in world space, and stand for LOD4 bodies
+	ObjectUniforms object;
+	object.model = glm::mat4();
+	object.colour = glm::vec4(Colour[4], 1.0f);
+	for (const Mesh* proxy : proxies)
+		backend.Draw(*proxy, bodyVariant(4, wireframe), &object, 1, 4);
+}
 
-	// Create a GLFWwindow object that we can use for GLFW's functions
-	GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, "LOD Animation", glfwGetPrimaryMonitor(), nullptr);
-	glfwMakeContextCurrent(window);
+// Camera & Light uniforms, shared by every lit and lamp draw this frame
+FrameUniforms frameUniforms(glm::mat4 projection, glm::mat4 view) {
+	FrameUniforms frame;
 
-	// Set the required callback functions
-	glfwSetKeyCallback(window, key_callback);
+	// Define Shader Attributes
+	frame.view = view;
+	frame.projection = projection;
+	frame.lightPos = glm::vec4(lightPos, 1.0f);
+	frame.lightColour = glm::vec4(1.0f, 0.9f, 0.8f, 1.0f);
+	frame.viewPos = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
 
-	// Set this to true so GLEW knows to use a modern approach to retrieving function pointers and extensions
-	glewExperimental = GL_TRUE;
+	return frame;
+}
 
-	// Initialize GLEW to setup the OpenGL Function pointers
-	glewInit();
+// Draw Light Source
+void drawSun(RenderBackend& backend, Model& sunModel, float modelSize) {
+	// Translate Model to 'light position' and scale model to size
+	sunModel.transformRS(lightPos, glm::vec3(0.0f, 1.0f, 0.0f), 0.0f, glm::vec3(modelSize));
 
-	// Define the viewport dimensions
-	glViewport(0, 0, WIDTH, HEIGHT);
+	// Unlit, flat sun colour
+	sunModel.changeColour(glm::vec3(1.0f, 0.9f, 0.0f));
 
-	// Enable MSAA
-	//glEnable(GL_MULTISAMPLE);
+	// Draw Model
+	backend.BeginPass("Sun");
+	sunModel.Draw(backend, objectVariant());
+	backend.EndPass();
+}
 
-	// Enable Depth Test / Z Buffer
-	glEnable(GL_DEPTH_TEST);
-	glDepthFunc(GL_LESS);
+// What the last frame drew, counted by the draw path
+void drawFrameStats(Shader& textProgram, float x) {
+	const FrameCounters& stats = FrameStats::Shared().Last();
 
-	// Enable Blending 
-	glEnable(GL_CULL_FACE);
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	std::ostringstream line;
+	line << "Triangles: " << stats.total.triangles << "   Vertices: " << stats.total.vertices << "   Draws: " << stats.total.drawCalls
+		<< "   State changes: " << stats.StateChanges() << " (" << stats.elidedCalls << " elided)" << "   Uploaded: " << std::fixed << std::setprecision(1) << stats.uploadBytes / 1024.0 << " KB";
+	RenderText(textProgram, line.str(), x, 1050.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f));
 
+	std::ostringstream levels;
+	levels << "Triangles per level:";
+	for (int l = 0; l < STATS_LEVELS; l++)
+		levels << "   L" << l << " " << stats.levels[l].triangles;
+	RenderText(textProgram, levels.str(), x, 1025.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f));
+}
 
-/// SHADERS -----------------------------------------------------------------------------------------------
-/// -------------------------------------------------------------------------------------------------------
-/// -------------------------------------------------------------------------------------------------------
-	// Compile Shaders
-	Shader lightingProgram("../shaders/lighting.vert", "../shaders/lighting.frag");
-	Shader lampProgram("../shaders/lamp.vert", "../shaders/lamp.frag");
-	Shader textProgram("../shaders/text.vert", "../shaders/text.frag");
+// Rolling GPU time of each pass, under the draw statistics
+void drawGpuPasses(Shader& textProgram, float x) {
+	std::ostringstream line;
+	line << "GPU ms:" << std::fixed << std::setprecision(2);
+	const vector<GpuPassStats>& passes = GpuProfiler::Shared().Passes();
+	for (size_t i = 0; i < passes.size(); i++)
+		line << "  " << passes[i].name << " " << passes[i].averageMs;
+	RenderText(textProgram, line.str(), x, 1000.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f));
+}
 
+// Rolling CPU zone timings, top right of the screen
+void drawProfiler(Shader& textProgram) {
+	RenderText(textProgram, "(P) Profiler   (T) Trace", 1480.0f, 1050.0f, 0.4f, glm::vec3(1.0f, 1.0f, 0.0f));
+	RenderText(textProgram, "Zone (ms / frame)         min     avg     p99", 1480.0f, 1025.0f, 0.4f, glm::vec3(1.0f, 1.0f, 0.0f));
+
+	const vector<ZoneStats>& stats = Profiler::Shared().Stats();
+	for (size_t i = 0; i < stats.size(); i++) {
+		std::ostringstream line;
+		line << std::left << std::setw(24) << stats[i].name << std::right << std::fixed << std::setprecision(2)
+			<< std::setw(8) << stats[i].minMs << std::setw(8) << stats[i].avgMs << std::setw(8) << stats[i].p99Ms;
+		RenderText(textProgram, line.str(), 1480.0f, 1000.0f - i * 22.0f, 0.4f, glm::vec3(1.0f, 1.0f, 0.0f));
+	}
+}
 
-/// TEXT --------------------------------------------------------------------------------------------------
-/// -------------------------------------------------------------------------------------------------------
-/// -------------------------------------------------------------------------------------------------------
-	glm::mat4 textProjection = glm::ortho(0.0f, static_cast<GLfloat>(WIDTH), 0.0f, static_cast<GLfloat>(HEIGHT));
-	textProgram.Use();
-	glUniformMatrix4fv(glGetUniformLocation(textProgram.Program, "projection"), 1, GL_FALSE, glm::value_ptr(textProjection));
+// Glyph textures of the first 128 ASCII characters and the quad buffer text is drawn with
+void loadFont(const char* path) {
 	// FreeType
 	FT_Library ft;
 	// All functions return a value different than 0 whenever an error occurred
@@ -358,7 +500,7 @@ int main()
 
 	// Load font as face
 	FT_Face face;
-	if (FT_New_Face(ft, "../fonts/arial.ttf", 0, &face))
+	if (FT_New_Face(ft, path, 0, &face))
 		std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
 
 	// Set size to load glyphs as
@@ -421,12 +563,422 @@ int main()
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindVertexArray(0);
 
+}
+
+// Execute a recorded command stream instead of drawing the scene, the driver's cost without the engine's
+int replayCommands(RenderContext& context, GLCommandReplay& commands, PerfReport* report, const RunOptions& options) {
+	int renderedFrames = 0;
+	while (!context.ShouldClose() && !commands.Finished())
+	{
+		Profiler::Shared().EndFrame();
+		PROFILE_ZONE("Frame");
+		context.PollEvents();
+		context.BeginFrame();
+		{
+			PROFILE_ZONE("Command Replay");
+			commands.Next();
+		}
+		FrameStats::Shared().EndFrame(renderedFrames * options.step);
+		{
+			PROFILE_ZONE("Swap");
+			context.Present();
+		}
+
+		renderedFrames++;
+		if (report) {
+			report->Frame(FrameStats::Shared().Last());
+			if ((options.frames > 0 && renderedFrames >= options.frames) || (options.seconds > 0.0 && report->Seconds() >= options.seconds))
+				break;
+		}
+	}
+
+	std::cout << "Command replay: " << renderedFrames << " of " << commands.Frames() << " frames" << std::endl;
+	if (report)
+		report->Write(options.report);
+	return 0;
+}
+
+// Distance table from "d0,d1,d2,d3[,d4]", false unless they're distances a table file accepts. Without d4 the
+// impostor distance is left as it was
+bool parseDistances(const char* text, float distances[5]) {
+	float parsed[5];
+	const int count = std::sscanf(text, "%f,%f,%f,%f,%f", &parsed[0], &parsed[1], &parsed[2], &parsed[3], &parsed[4]);
+	if (count < 4 || !LODTable::ValidDistances(parsed, count))
+		return false;
+	std::copy(parsed, parsed + count, distances);
+	return true;
+}
+
+// A number greater than zero with nothing after it, false for anything else
+bool parsePositive(const char* text, double& value) {
+	char* end;
+	value = std::strtod(text, &end);
+	return end != text && *end == '\0' && value > 0.0;
+}
+
+// Render every body level at distances from near to the far plane, and write the distances where each level's
+// error stays under the targets. Other assets already in the table are kept
+int tuneLOD(RenderBackend& backend, vector<Model>& levels, glm::mat4 projection, int width, int height, LODTable& table, const RunOptions& options) {
+	unsigned variants[5];
+	for (int level = 0; level < 5; level++)
+		variants[level] = bodyVariant(level, false);
+
+	LODTuner tuner(backend, width, height, projection);
+	tuner.Measure(levels, variants, 2.0f, 200.0f, 48);
+
+	// The impostor is an exact sphere, so error can't place it. Its distance is a fill cost choice and is kept
+	float normal[5], exaggerated[5];
+	tuner.SwitchDistances(options.tunePSNR, normal);
+	tuner.SwitchDistances(options.tunePSNR - TUNE_EXAGGERATION, exaggerated);
+	normal[4] = std::max(LODDistances[4], normal[3]);
+	exaggerated[4] = std::max(ExaggeratedDistances[4], exaggerated[3]);
+	table.Set(BODY_ASSET, "normal", normal);
+	table.Set(BODY_ASSET, "exaggerated", exaggerated);
+
+	// Worst PSNR of each level by distance, to see how close the table is to the target
+	std::cout << "LOD tuning, PSNR against L0 at " << width << "x" << height << ":" << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	for (const LODSample& sample : tuner.Samples()) {
+		std::cout << "  " << std::setw(6) << sample.distance;
+		for (int level = 1; level < 5; level++)
+			std::cout << "   L" << level << " " << std::setw(5) << sample.psnr[level];
+		std::cout << std::endl;
+	}
+	std::cout << "Normal (" << options.tunePSNR << " dB): " << normal[0] << " " << normal[1] << " " << normal[2] << " " << normal[3] << ", impostors beyond " << normal[4] << std::endl;
+	std::cout << "Exaggerated (" << options.tunePSNR - TUNE_EXAGGERATION << " dB): " << exaggerated[0] << " " << exaggerated[1] << " "
+		<< exaggerated[2] << " " << exaggerated[3] << ", impostors beyond " << exaggerated[4] << std::endl;
+
+	std::ostringstream comment;
+	comment << "LOD switch distances, written by LODAnim --tune-lod at " << width << "x" << height << "\n"
+		<< "normal keeps every level above " << options.tunePSNR << " dB PSNR against L0, exaggerated above " << options.tunePSNR - TUNE_EXAGGERATION << " dB";
+	return table.Write(options.tuneLOD, comment.str()) ? 0 : 1;
+}
+
+// Read the command line, false if it can't be understood
+bool parseArguments(int argc, char** argv, RunOptions& options) {
+	options.context.headless = false;
+	options.context.width = WIDTH;
+	options.context.height = HEIGHT;
+	options.context.vsync = true;
+	options.frames = 0;
+	options.seconds = 0.0;
+	options.step = 1.0 / 60.0;
+	options.timeline = "../Timelines/default.timeline";
+	options.backend = "gl";
+	options.glNull = false;
+	options.sortDraws = true;
+	options.captureFormat = CAPTURE_PNG;
+	options.lodTable = "../Models/lod.table";
+	options.tunePSNR = 40.0;
+	options.octahedral = false;
+	options.bakeImpostors = false;
+	options.hlod = true;
+	float distances[5];
+	bool clockGiven = false;
+
+	for (int i = 1; i < argc; i++) {
+		const bool hasValue = i + 1 < argc;
+		if (std::strcmp(argv[i], "--headless") == 0)
+			options.context.headless = true;
+		else if (std::strcmp(argv[i], "--width") == 0 && hasValue)
+			options.context.width = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "--height") == 0 && hasValue)
+			options.context.height = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "--frames") == 0 && hasValue)
+			options.frames = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "--seconds") == 0 && hasValue)
+			options.seconds = std::atof(argv[++i]);
+		else if (std::strcmp(argv[i], "--report") == 0 && hasValue)
+			options.report = argv[++i];
+		else if (std::strcmp(argv[i], "--clock") == 0 && hasValue && Clock::ParseMode(argv[i + 1], options.clock)) {
+			clockGiven = true;
+			i++;
+		}
+		else if (std::strcmp(argv[i], "--step") == 0 && hasValue)
+			options.step = std::atof(argv[++i]);
+		else if (std::strcmp(argv[i], "--timeline") == 0 && hasValue)
+			options.timeline = argv[++i];
+		else if (std::strcmp(argv[i], "--record") == 0 && hasValue)
+			options.record = argv[++i];
+		else if (std::strcmp(argv[i], "--replay") == 0 && hasValue)
+			options.replay = argv[++i];
+		else if (std::strcmp(argv[i], "--backend") == 0 && hasValue && (std::strcmp(argv[i + 1], "gl") == 0 || std::strcmp(argv[i + 1], "software") == 0))
+			options.backend = argv[++i];
+		else if (std::strcmp(argv[i], "--gl-null") == 0)
+			options.glNull = true;
+		else if (std::strcmp(argv[i], "--gl-record") == 0 && hasValue)
+			options.glRecord = argv[++i];
+		else if (std::strcmp(argv[i], "--gl-replay") == 0 && hasValue)
+			options.glReplay = argv[++i];
+		else if (std::strcmp(argv[i], "--draw-order") == 0 && hasValue && (std::strcmp(argv[i + 1], "sorted") == 0 || std::strcmp(argv[i + 1], "submitted") == 0))
+			options.sortDraws = std::strcmp(argv[++i], "sorted") == 0;
+		else if (std::strcmp(argv[i], "--capture") == 0 && hasValue)
+			options.capture = argv[++i];
+		else if (std::strcmp(argv[i], "--capture-format") == 0 && hasValue && (std::strcmp(argv[i + 1], "png") == 0 || std::strcmp(argv[i + 1], "raw") == 0))
+			options.captureFormat = std::strcmp(argv[++i], "png") == 0 ? CAPTURE_PNG : CAPTURE_RAW;
+		else if (std::strcmp(argv[i], "--lod-error") == 0 && hasValue)
+			options.lodError = argv[++i];
+		else if (std::strcmp(argv[i], "--distances") == 0 && hasValue && parseDistances(argv[i + 1], distances))
+			options.distances = argv[++i];
+		else if (std::strcmp(argv[i], "--lod-table") == 0 && hasValue)
+			options.lodTable = argv[++i];
+		else if (std::strcmp(argv[i], "--tune-lod") == 0 && hasValue)
+			options.tuneLOD = argv[++i];
+		else if (std::strcmp(argv[i], "--tune-psnr") == 0 && hasValue && parsePositive(argv[i + 1], options.tunePSNR))
+			i++;
+		else if (std::strcmp(argv[i], "--impostors") == 0 && hasValue && (std::strcmp(argv[i + 1], "sphere") == 0 || std::strcmp(argv[i + 1], "octahedral") == 0))
+			options.octahedral = std::strcmp(argv[++i], "octahedral") == 0;
+		else if (std::strcmp(argv[i], "--bake-impostors") == 0)
+			options.octahedral = options.bakeImpostors = true;
+		else if (std::strcmp(argv[i], "--hlod") == 0 && hasValue && (std::strcmp(argv[i + 1], "on") == 0 || std::strcmp(argv[i + 1], "off") == 0))
+			options.hlod = std::strcmp(argv[++i], "on") == 0;
+		else {
+			std::cout << "Usage: LODAnim [--headless] [--width W] [--height H] [--frames N] [--seconds S] [--report path|-]"
+				" [--clock realtime|fixed|fast] [--step seconds] [--timeline path] [--record path] [--replay path] [--backend gl|software]"
+				" [--gl-null] [--gl-record path] [--gl-replay path] [--draw-order sorted|submitted]"
+				" [--capture directory] [--capture-format png|raw] [--lod-error path] [--distances d0,d1,d2,d3[,d4]]"
+				" [--lod-table path] [--tune-lod path] [--tune-psnr dB] [--impostors sphere|octahedral] [--bake-impostors]"
+				" [--hlod on|off]" << std::endl;
+			return false;
+		}
+	}
+	if (options.context.width <= 0 || options.context.height <= 0 || options.step <= 0.0) {
+		std::cout << "ERROR::ARGUMENTS:: Resolution and step must be positive" << std::endl;
+		return false;
+	}
+
+	// The software backend has no window to show its frames in
+	if (options.backend == "software")
+		options.context.headless = true;
+	if (options.backend == "software" && (options.glNull || !options.glRecord.empty() || !options.glReplay.empty())) {
+		std::cout << "ERROR::ARGUMENTS:: --gl-null, --gl-record and --gl-replay need the gl backend" << std::endl;
+		return false;
+	}
+
+	// Captures read the GL framebuffer back, null frames never draw into it
+	if (!options.capture.empty() && (options.backend == "software" || options.glNull || !options.glReplay.empty())) {
+		std::cout << "ERROR::ARGUMENTS:: --capture needs the gl backend drawing the scene" << std::endl;
+		return false;
+	}
+
+	// Atlases are baked with GL, and nothing else could sample them
+	if (options.octahedral && options.backend == "software") {
+		std::cout << "ERROR::ARGUMENTS:: --impostors octahedral needs the gl backend" << std::endl;
+		return false;
+	}
+
+	if ((!options.lodError.empty() || !options.tuneLOD.empty()) && (options.glNull || !options.glReplay.empty())) {
+		std::cout << "ERROR::ARGUMENTS:: --lod-error and --tune-lod need frames that draw the scene" << std::endl;
+		return false;
+	}
+
+	// Null frames show nothing, so they only make sense as a benchmark
+	if (options.glNull)
+		options.context.headless = true;
+
+	// Benchmarks shouldn't wait for the display, always report, and draw the same frames every run
+	const bool benchmark = options.context.headless || options.frames > 0 || options.seconds > 0.0 || !options.replay.empty() || !options.glReplay.empty();
+	if (benchmark) {
+		options.context.vsync = false;
+		if (options.report.empty())
+			options.report = "-";
+	}
+	if (!clockGiven)
+		options.clock = benchmark ? UNLIMITED_CLOCK : REALTIME_CLOCK;
+	if (!options.replay.empty())
+		options.clock = REPLAY_CLOCK;
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	RunOptions options;
+	if (!parseArguments(argc, argv, options))
+		return 1;
+	octahedralImpostors = options.octahedral;
+
+	// A report on standard output must parse as JSON, the log goes to standard error instead
+	if (options.report == "-")
+		PerfReport::ReserveStandardOutput();
+
+	// A replay draws the recording's frames, at its resolution and from its timeline
+	SessionReplay replay;
+	const bool replaying = !options.replay.empty();
+	if (replaying) {
+		if (!replay.Open(options.replay))
+			return 1;
+		options.context.width = replay.Header().width;
+		options.context.height = replay.Header().height;
+		options.timeline = replay.Header().timeline;
+	}
+
+/// CLOCK -------------------------------------------------------------------------------------------------
+/// -------------------------------------------------------------------------------------------------------
+/// -------------------------------------------------------------------------------------------------------
+	animationClock = Clock(options.clock, options.step);
+
+
+/// TIMELINE ----------------------------------------------------------------------------------------------
+/// -------------------------------------------------------------------------------------------------------
+/// -------------------------------------------------------------------------------------------------------
+	// What draws when, mode switches and camera keyframes, read before anything is sized from it
+	Timeline timeline;
+	if (!timeline.Load(options.timeline, sceneSets))
+		return 1;
+
+	// Switch distances of the bodies, --distances still wins for normal mode
+	LODTable lodTable;
+	if (!lodTable.Load(options.lodTable))
+		return 1;
+	if (!lodTable.Get(BODY_ASSET, "normal", LODDistances) || !lodTable.Get(BODY_ASSET, "exaggerated", ExaggeratedDistances))
+		std::cout << "LOD TABLE: " << options.lodTable << " is missing a " << BODY_ASSET << " table, using the built-in distances" << std::endl;
+	if (!options.distances.empty())
+		parseDistances(options.distances.c_str(), LODDistances);
+
+	// Everything needed to draw this run's frames again
+	if (!options.record.empty()) {
+		SessionHeader header = { options.context.width, options.context.height, options.timeline };
+		if (!recorder.Open(options.record, header))
+			return 1;
+	}
+
+
+/// OPENGL ------------------------------------------------------------------------------------------------
+/// -------------------------------------------------------------------------------------------------------
+/// -------------------------------------------------------------------------------------------------------
+	// Fullscreen window, or an offscreen framebuffer when headless. The software backend needs no GL context at all
+	const bool software = options.backend == "software";
+	const int width = options.context.width, height = options.context.height;
+	std::unique_ptr<RenderContext> context;
+	if (!software) {
+		try {
+			context.reset(new RenderContext(options.context));
+		}
+		catch (const char* error) {
+			std::cout << error;
+			return 1;
+		}
+	}
+	GLFWwindow* window = context ? context->Window() : nullptr;
+
+	// Set the required callback functions, a replay takes its keys from the log instead
+	if (window && !replaying)
+		glfwSetKeyCallback(window, key_callback);
+
+	// Vertex format of the geometry arena, must be chosen before any Model loads. Software meshes stay on the CPU
+	GeometryArena::UsePackedVertices(PACKED_VERTICES);
+	GeometryArena::UseCPUOnly(software);
+
+	// Every field body's uniforms go through the ring each frame, plus alignment for each instanced draw. An HLOD
+	// proxy's aligned draw takes less than the HLOD_MIN_MEMBERS bodies it replaces
+	const int fieldSize = timeline.LargestField();
+	UniformRing::UseSegmentSize((1 << 17) + fieldSize * (GLsizeiptr)sizeof(ObjectUniforms) + (fieldSize / MAX_INSTANCES + LOD_LEVELS) * 256);
+
+	if (context) {
+		// Enable MSAA
+		//glEnable(GL_MULTISAMPLE);
+
+		// Enable Depth Test / Z Buffer
+		GLDispatch::Shared().Enable(GL_DEPTH_TEST);
+		glDepthFunc(GL_LESS);
+
+		// Enable Blending
+		GLDispatch::Shared().Enable(GL_CULL_FACE);
+		GLDispatch::Shared().Enable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		// State changes and draws go through the dispatch, null frames are recorded but never reach the driver
+		if (options.glNull)
+			GLDispatch::Shared().SetMode(DISPATCH_NULL);
+		else if (!options.glRecord.empty())
+			GLDispatch::Shared().SetMode(DISPATCH_RECORD);
+		if (!options.glRecord.empty() && !GLDispatch::Shared().RecordTo(options.glRecord))
+			return 1;
+	}
+
+
+/// SHADERS -----------------------------------------------------------------------------------------------
+/// -------------------------------------------------------------------------------------------------------
+/// -------------------------------------------------------------------------------------------------------
+	// Everything in the scene draws through the backend, text and the HUD only exist with GL
+	std::unique_ptr<RenderBackend> backend;
+	SoftwareBackend* rasterizer = nullptr;
+	GLBackend* glBackend = nullptr;
+	std::unique_ptr<ShaderVariants> variants;
+	std::unique_ptr<ShaderManager> shaders;
+	Shader* textProgram = nullptr;
+
+	if (context) {
+		// One uber shader, every program is a permutation of it
+		variants.reset(new ShaderVariants("../Shaders/uber.glsl"));
+
+		// Submit every program up front, they compile while fonts and models load. Objects draw flat until then
+		shaders.reset(new ShaderManager(window, variants->Build(objectVariant())));
+
+		// Attach per-frame and per-object uniform blocks to the uniform ring's binding points
+		shaders->BindBlock("FrameBlock", FRAME_BLOCK_BINDING);
+		shaders->BindBlock("ObjectBlock", OBJECT_BLOCK_BINDING);
+
+		// Every variant the scene can bind, both normal matrix paths so N can switch between them
+		bool normalPaths[] = { false, true };
+		for (bool perVertex : normalPaths) {
+			perVertexNormals = perVertex;
+			variants->Submit(*shaders, bodyVariant(0, false)); // Near bodies, with specular
+			variants->Submit(*shaders, bodyVariant(4, false)); // Far bodies
+			variants->Submit(*shaders, bodyVariant(0, true)); // Wireframe bodies, any level
+			variants->Submit(*shaders, bodyVariant(IMPOSTOR_LEVEL, false)); // Farthest bodies, wireframe or not
+			variants->Submit(*shaders, ringVariant());
+			if (fieldSize > 0) {
+				variants->Submit(*shaders, bodyVariant(0, false) | VARIANT_INSTANCED); // Field, one draw per level
+				variants->Submit(*shaders, bodyVariant(4, false) | VARIANT_INSTANCED);
+				variants->Submit(*shaders, bodyVariant(0, true) | VARIANT_INSTANCED);
+				variants->Submit(*shaders, bodyVariant(IMPOSTOR_LEVEL, false) | VARIANT_INSTANCED);
+			}
+		}
+		perVertexNormals = false;
+		if (octahedralImpostors) {
+			variants->Submit(*shaders, bakeVariant(), false); // Only used once every program is ready
+
+			// Atlas maps stay bound to their own units
+			auto bindAtlas = [](Shader& program) {
+				glUseProgram(program.Program);
+				glUniform1i(glGetUniformLocation(program.Program, "impostorAlbedo"), IMPOSTOR_ALBEDO_UNIT);
+				glUniform1i(glGetUniformLocation(program.Program, "impostorNormalDepth"), IMPOSTOR_NORMAL_DEPTH_UNIT);
+			};
+			shaders->OnReady(variants->Get(bodyVariant(IMPOSTOR_LEVEL, false)), bindAtlas);
+			if (fieldSize > 0)
+				shaders->OnReady(variants->Get(bodyVariant(IMPOSTOR_LEVEL, false) | VARIANT_INSTANCED), bindAtlas);
+		}
+		variants->Submit(*shaders, objectVariant()); // Sun
+		variants->Submit(*shaders, VARIANT_TEXT, false); // Text is skipped until ready
+		textProgram = &variants->Get(VARIANT_TEXT);
+
+		glm::mat4 textProjection = glm::ortho(0.0f, static_cast<GLfloat>(WIDTH), 0.0f, static_cast<GLfloat>(HEIGHT));
+		shaders->OnReady(*textProgram, [textProjection](Shader& program) {
+			// Set up once, straight to GL so it happens even when frames only go to the null dispatch
+			glUseProgram(program.Program);
+			glUniformMatrix4fv(glGetUniformLocation(program.Program, "projection"), 1, GL_FALSE, glm::value_ptr(textProjection));
+		});
+		shaders->Start();
+
+		// Glyphs load while the programs compile
+		loadFont("../fonts/arial.ttf");
+
+		glBackend = new GLBackend(*variants, width, height);
+		glBackend->SortDraws(options.sortDraws);
+		backend.reset(glBackend);
+	}
+	else {
+		rasterizer = new SoftwareBackend(width, height);
+		backend.reset(rasterizer);
+	}
+
 
 /// MODELS ------------------------------------------------------------------------------------------------
 /// -------------------------------------------------------------------------------------------------------
 /// -------------------------------------------------------------------------------------------------------
-	// Create vector to store: Models, Wire Models, Model Colours, Distances
-	vector<Model> Models, Wires; vector<glm::vec3> colours, white; float Distances[5];
+	// Create vector to store: Models, Model Colours, Distances
+	vector<Model> Models; vector<glm::vec3> colours, white; float Distances[5];
 	
 	// Load Orbit Path Model
 	Model circum("../Models/circumference.obj");
@@ -440,14 +992,10 @@ int main()
 		Models.push_back(model);
 	}
 
-	// Load Wire Models into vector
-	for (int i = 0; i < 5; i++) {
-		string filename = "../Models/";
-		filename.append(to_string(i));
-		filename.append("w.obj");
-		Model model(filename);
-		Wires.push_back(model);
-	}
+	// Impostor quad the size of LOD0, the last level
+	MeshData quad;
+	ImpostorQuad(Models[0].Radius(), quad.vertices, quad.indices);
+	Models.push_back(Model(quad));
 
 	// Load colours into vector
 	colours.push_back(glm::vec3(1.0f, 1.0f, 1.0f));
@@ -455,12 +1003,17 @@ int main()
 	colours.push_back(glm::vec3(1.0f, 1.0f, 0.0f));
 	colours.push_back(glm::vec3(1.0f, 0.3f, 0.0f));
 	colours.push_back(glm::vec3(1.0f, 0.0f, 0.0f));
+	colours.push_back(glm::vec3(0.6f, 0.2f, 1.0f));
 
 	// Load white colours into vector
-	for (int i = 0; i < 5; i++) {
+	for (int i = 0; i < LOD_LEVELS; i++) {
 		white.push_back(glm::vec3(1.0f, 1.0f, 1.0f));
 	}
 
+	// Report how the LOD chain and orbit ring were packed into the shared buffers
+	if (!GeometryArena::CPUOnly())
+		GeometryArena::Shared().Report(std::cout);
+
 	// Define Orbit Attributes
 	vector<int> Radius = { 6, 9, 12, 15, 18 };
 	vector<float> Speed = { 2.0f, 3.3f, 5.3f, 8.9f, 11.7f };
@@ -479,146 +1032,438 @@ int main()
 	float x = 0, y = 0, z = 0;
 
 	// Projection Perspective Matrix
-	glm::mat4 projection = glm::perspective(glm::radians((float)FOV), (float)WIDTH / (float)HEIGHT, 0.1f, 210.0f);
-
-	// Start clock now that animation has loaded
-	duration = clock() - start;
-
-/// RENDER LOOP --------------------------------------------------------------------------------------------
-/// --------------------------------------------------------------------------------------------------------
-/// --------------------------------------------------------------------------------------------------------
-	while (!glfwWindowShouldClose(window))
-	{
-		
-		// Check if any events have taken place
-		glfwPollEvents();
-
-		// Clear the colorbuffer
-		glClearColor(0.25f, 0.25f, 0.35f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-		
-		// Activate Shader
-		setupLightSource(lightingProgram);
-		passMatrixToShader(lightingProgram, projection, view);	
-
-		// Clock starts here
-		currentTime = (clock() / 1000.0f) - (duration / 1000.0f) - (3);
-
-		// Display Title
-		if (currentTime > 0 & currentTime < 5) {
-			RenderText(textProgram, "The Level of Detail Algorithm", 310.0f, 840.0f, 2.0f, glm::vec3(1.0f, 0.2f, 0.2f));			
-		}
-
-		// Display Orbiting Spheres
-		if (currentTime > 0 & currentTime < 15) {
-			RenderText(textProgram, getMode(), 5.0f, 5.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f)); // Render text: Mode
-			RenderText(textProgram, "(C) Change Camera Position", 5.0f, 30.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f)); // Display Camera Position Instruction
-			lightingProgram.Use(); // Switch back to correct shader
-
-			// check if wireframe mode is enabled
-			if (wireframe) { 
-				// Draw Sphere's
-				for (int i = 0; i < 5; i++) {
-					Orbit(Wires, circum, lightingProgram, Radius[i], Speed[i], RotateSpeed[i], white, rotateZ);
-				}
-				RenderText(textProgram, "(W) Wireframe Mode: ON", 5.0f, 55.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f));
+	glm::mat4 projection = glm::perspective(glm::radians((float)FOV), (float)width / (float)height, 0.1f, 210.0f);
+
+	// Orbit paths collected while drawing the bodies, drawn together afterwards
+	vector<ObjectUniforms> rings;
+
+	// Scene sets start hidden, the timeline shows them
+	Scene scene = {};
+	vector<FieldBody> field;
+	vector<ObjectUniforms> fieldLevels[LOD_LEVELS];
+
+	// Clusters of a static field, built from LOD4 when the field is generated
+	bool fieldOrbits = true;
+	HLOD hlod;
+	double hlodUntimedMs = 0.0, hlodTimedMs = 0.0;
+	auto buildHLOD = [&](const vector<FieldBody>& bodies) {
+		vector<glm::vec3> positions;
+		for (const FieldBody& body : bodies)
+			positions.push_back(fieldPosition(body, 0.0f, false));
+		hlod.Build(positions, Models[4].Meshes()[0], Models[4].Radius());
+		std::cout << "HLOD: " << bodies.size() << " bodies in " << hlod.Clusters() << " clusters, " << hlod.Proxies() << " proxies of "
+			<< hlod.ProxyTriangles() << " triangles for " << hlod.SourceTriangles() << " LOD4 triangles, built in "
+			<< std::fixed << std::setprecision(1) << hlod.BuildMs() << " ms" << std::endl;
+	};
+
+	// The timeline's first static field, generated and clustered before the render loop
+	const TimelineEvent* prebuiltEvent = nullptr;
+	vector<FieldBody> prebuiltField;
+
+	// Run once per event as the timeline passes it
+	auto apply = [&](const TimelineEvent& event) {
+		switch (event.command) {
+		case TIMELINE_SHOW:
+		case TIMELINE_HIDE:
+			sceneSet(scene, event.name) = event.command == TIMELINE_SHOW;
+			break;
+		case TIMELINE_MODE:
+			mode = event.value;
+			break;
+		case TIMELINE_PALETTE:
+			scene.whitePalette = event.name == "white";
+			break;
+		case TIMELINE_CAMERA:
+			cameraMoveTo(event.position, event.target);
+			break;
+		case TIMELINE_FIELD:
+			fieldOrbits = event.name != "static";
+			if (&event == prebuiltEvent) {
+				field.swap(prebuiltField);
+				prebuiltEvent = nullptr;
 			}
 			else {
-				// Draw Sphere's
-				for (int i = 0; i < 5; i++) {
-					Orbit(Models, circum, lightingProgram, Radius[i], Speed[i], RotateSpeed[i], white, rotateZ);
+				field = generateField(event.value, event.seed);
+
+				// Orbiting fields draw without clusters, so a prebuilt field still to come keeps its own
+				if (!fieldOrbits && options.hlod) {
+					buildHLOD(field);
+					hlodTimedMs += hlod.BuildMs();
 				}
-				RenderText(textProgram, "(W) Wireframe Mode: OFF", 5.0f, 55.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f));
 			}
+			scene.field = !field.empty();
+			break;
+		case TIMELINE_END:
+			break;
+		}
+	};
 
-			// Create Polygon count string
-			string polygon = "Polygon Count: ";
-			polygon.append(to_string(polyCount[0]));
+	// GPU time of the orbiting spheres and rings is used to compare normal matrix paths
+	bool timedPerVertex = perVertexNormals;
+
+	// Benchmark runs report on exit
+	std::unique_ptr<PerfReport> report;
+	if (!options.report.empty()) {
+		if (context) {
+			const GLubyte* renderer = glGetString(GL_RENDERER);
+			report.reset(new PerfReport(context->Backend(), renderer ? (const char*)renderer : "", width, height));
+		}
+		else {
+			report.reset(new PerfReport("software rasterizer", rasterizer->Description(), width, height));
+			report->TimeGpuPasses(false);
+		}
+		report->SetClock(Clock::ModeName(animationClock.Mode()), animationClock.Step());
+		report->ListFrames(replaying);
+	}
+	std::string finalHash;
+	std::vector<unsigned char> finalPixels;
+	int renderedFrames = 0;
+
+	// Every frame read back without stalling the render thread, encoded while later frames draw
+	std::unique_ptr<FrameCapture> capture;
+	if (!options.capture.empty())
+		capture.reset(new FrameCapture(width, height, options.capture, options.captureFormat));
+
+	// Each frame's difference from an LOD0 render of it, logged against both triangle counts
+	std::unique_ptr<LODErrorLog> lodError;
+	ImageComparer comparer;
+	std::vector<unsigned char> referencePixels, lodPixels;
+	double referenceMs = 0.0;
+	if (!options.lodError.empty()) {
+		lodError.reset(new LODErrorLog());
+		if (!lodError->Open(options.lodError))
+			return 1;
+	}
 
-			// Render polygon count string
-			RenderText(textProgram, polygon, 5.0f, 1050.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f));
+	// Reproducible runs can't have frames drawn with the fallback program, finish compiling first. A command
+	// replay names the programs the recording used, they must all exist
+	if (shaders && (animationClock.Deterministic() || !options.glReplay.empty() || !options.tuneLOD.empty() || octahedralImpostors)) {
+		while (!shaders->Ready()) {
+			shaders->Update();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
 
-			// Draw Sun Light Source
-			drawSun(lampProgram, Models[3], 3.0f);
-			passMatrixToShader(lampProgram, projection, view);
+	// Last level of the bodies from LOD0 seen from every direction, cached next to the model. Baked before a
+	// command replay too, its frames sample the atlas
+	ImpostorAtlas atlas;
+	if (octahedralImpostors) {
+		const std::string bakeSource = variants->Stage(GL_VERTEX_SHADER, bakeVariant()) + variants->Stage(GL_GEOMETRY_SHADER, bakeVariant())
+			+ variants->Stage(GL_FRAGMENT_SHADER, bakeVariant());
+		const std::string cache = ImpostorAtlas::CachePath(Models[0].Path(), Models[0].Meshes()[0], Models[0].Radius(), bakeSource);
+		if (options.bakeImpostors || !atlas.Load(cache)) {
+			atlas.Bake(Models[0].Meshes()[0], variants->Get(bakeVariant()), Models[0].Radius());
+			std::cout << "Impostor atlas: baked in " << std::fixed << std::setprecision(1) << atlas.BakeMs() << " ms, cached as " << cache << std::endl;
+			atlas.Write(cache);
 		}
-		// Display orbiting models
-		if (currentTime > 32) {
-			RenderText(textProgram, getMode(), 5.0f, 5.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f)); // Render text: Mode
-			RenderText(textProgram, "(C) Change Camera Position", 5.0f, 30.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f)); // Display Camera Position Instruction
-			lightingProgram.Use(); // Switch back to correct shader
+		atlas.Bind();
+	}
 
-			// Check if wireframe mode is enabled
-			if (wireframe) {
-				// Draw Sphere's
-				for (int i = 0; i < 5; i++) {
-					Orbit(Wires, circum, lightingProgram, Radius[i], Speed[i], RotateSpeed[i], colours, rotateZ);
-				}
-				RenderText(textProgram, "(W) Wireframe Mode: ON", 5.0f, 55.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f));
+	// Offline tuning renders the body levels alone instead of running the scene
+	if (!options.tuneLOD.empty())
+		return tuneLOD(*backend, Models, projection, width, height, lodTable, options);
+
+	// Recorded frames replace the scene, the resources they name were all created above
+	if (!options.glReplay.empty()) {
+		GLCommandReplay commands;
+		if (!commands.Open(options.glReplay))
+			return 1;
+		return replayCommands(*context, commands, report.get(), options);
+	}
+
+	// The whole scene through the backend. Measuring LOD error draws it in white, so only geometry differs
+	auto drawScene = [&]() {
+		vector<glm::vec3>& palette = scene.whitePalette || lodError ? white : colours;
+
+		// Clear the colorbuffer, Camera & Light for every object program
+		backend->BeginFrame(frameUniforms(projection, view), glm::vec4(0.25f, 0.25f, 0.35f, 1.0f));
+
+		backend->BeginPass("Bodies");
+
+		// Draw Sphere's, wireframe mode picks the edge overlay variant of the same meshes
+		if (scene.orbits) {
+			for (int i = 0; i < 5; i++) {
+				Orbit(Models, circum, *backend, rings, Radius[i], Speed[i], RotateSpeed[i], palette, rotateZ);
 			}
-			else {
-				// Draw Sphere's
-				for (int i = 0; i < 5; i++) {
-					Orbit(Models, circum, lightingProgram, Radius[i], Speed[i], RotateSpeed[i], colours, rotateZ);
-				}
-				RenderText(textProgram, "(W) Wireframe Mode: OFF", 5.0f, 55.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f));
+		}
+
+		// Display each level in sequence
+		if (scene.showcase) {
+			for (int i = 0; i < 5; i++) {
+				Models[4-i].transform(glm::vec3((float) (i*2)- 4, 25.0f, 9.0f));
+				Models[4-i].changeColour(colours[4-i]);
+				Models[4-i].Draw(*backend, bodyVariant(4 - i, false), 4 - i);
 			}
+		}
 
-			// Create Polygon count string
-			string polygon = "Polygon Count: ";
-			polygon.append(to_string(polyCount[0]));
+		// Render 5 sphere in far distance
+		if (scene.farRow) {
+			for (int i = 0; i < 5; i++) {
+				Models[4 - i].transform(glm::vec3((i*5) - 15, -160.0f, 2.0f));
+				Models[4 - i].changeColour(colours[4]);
+				Models[4 - i].Draw(*backend, bodyVariant(4 - i, false), 4 - i);
+			}
+		}
 
-			// Render polygon count string
-			RenderText(textProgram, polygon, 0.0f, 1050.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f));
+		// Generated field, instanced per LOD level
+		if (scene.field)
+			drawField(field, fieldOrbits, fieldOrbits || !options.hlod ? nullptr : &hlod, Models, *backend, palette, fieldLevels);
 
-			// Draw Sun Light Source
-			drawSun(lampProgram, Models[3], 3.0f);
-			passMatrixToShader(lampProgram, projection, view);
+		backend->EndPass();
+
+		// Orbit paths and Sun Light Source
+		if (scene.orbits) {
+			drawRings(circum, *backend, rings);
+			drawSun(*backend, Models[3], 3.0f);
 		}
-		else if (currentTime > 15 & currentTime < 32) {
-			// Display Level names
-			RenderText(textProgram, "L0              L1               L2               L3               L4", 280.0f, 350.0f, 1.3f, glm::vec3(1.0f, 0.0f, 0.0f));
-			lightingProgram.Use(); // Switch to correct Shader
 
-			// Display each level in sequence
-			for (int i = 0; i < 5; i++) {
-				Models[4-i].transform(lightingProgram, glm::vec3((float) (i*2)- 4, 25.0f, 9.0f));
-				Models[4-i].changeColour(lightingProgram, colours[4-i]);
-				Models[4-i].Draw(lightingProgram);
+		// Sort and run the queued draws, or rasterize what's left, and fence the uniform ring slice
+		backend->EndFrame();
+	};
+
+
+/// RENDER LOOP --------------------------------------------------------------------------------------------
+/// --------------------------------------------------------------------------------------------------------
+/// --------------------------------------------------------------------------------------------------------
+	// A large field's clusters take a good part of a second, far too long for a timed frame. The first static
+	// field's are built before the first one, its event only swaps the field in
+	if (options.hlod) {
+		for (const TimelineEvent& event : timeline.Events()) {
+			if (event.command == TIMELINE_FIELD && event.name == "static" && event.value > 0) {
+				prebuiltEvent = &event;
+				prebuiltField = generateField(event.value, event.seed);
+				buildHLOD(prebuiltField);
+				hlodUntimedMs += hlod.BuildMs();
+				break;
 			}
-			mode = 1; // Switch to Exaggerated LOD mode
 		}
-		// Move Camera to Position 2, Switch back to Normal LOD mode
-		if (currentTime > 47 & currentTime < 57) {
-			cameraMovePos2();
-			mode = 0;
+	}
+
+	Profiler::Shared().NameThread("Main");
+	while (!context || !context->ShouldClose())
+	{
+		// Collect last frame's zones, before this frame's zone opens
+		if (traceRequested) {
+			Profiler::Shared().RequestTrace("../trace.json");
+			traceRequested = false;
 		}
+		Profiler::Shared().EndFrame();
+		PROFILE_ZONE("Frame");
 
-		// Move Camera back to Position 1
-		if (currentTime > 57 & currentTime < 90){
-			cameraMovePos1();
+		// Check if any events have taken place
+		SessionFrame replayed;
+		{
+			PROFILE_ZONE("Poll Events");
+			if (context)
+				context->PollEvents();
+
+			// Recorded keys arrive at the same point in the frame they were pressed
+			if (replaying && replay.Next(replayed)) {
+				for (const SessionInput& input : replayed.inputs)
+					key_callback(window, input.key, 0, input.action, 0);
+			}
 		}
 
-		// Move Camera to Position 3
-		if (currentTime > 90 & currentTime < 105) {
-			cameraMovePos3();
-			lightingProgram.Use(); // Switch to correct Shader
+		if (context) {
+			// Window or offscreen target
+			context->BeginFrame();
 
-			// Render 5 sphere in far distance
-			for (int i = 0; i < 5; i++) {
-				Models[4 - i].transform(lightingProgram, glm::vec3((i*5) - 15, -160.0f, 2.0f));
-				Models[4 - i].changeColour(lightingProgram, colours[4]);
-				Models[4 - i].Draw(lightingProgram);
+			// Swap in any programs that finished compiling
+			shaders->Update();
+		}
+
+		// Clock starts here, now that animation has loaded. The first frame is time zero
+		currentTime = (float)(replaying ? animationClock.TickTo(replayed.time) : animationClock.Tick()) - 3;
+		recorder.Frame(animationClock.Time());
+
+		// Events passed since last frame, then wherever a linear camera move has got to
+		timeline.Advance(currentTime, apply);
+		glm::vec3 position, target;
+		if (timeline.CameraAt(currentTime, position, target))
+			cameraMoveTo(position, target);
+
+		// Every body at LOD0 first, then the frame as LOD selection draws it, compared before the title goes over it.
+		// The reference isn't part of the frame's draw counters, dispatch stream or GPU passes, only its time is
+		uint64_t referenceTriangles = 0;
+		if (lodError) {
+			PROFILE_ZONE("LOD Reference");
+			const uint64_t referenceStart = Profiler::Now();
+			const int selected = mode;
+			mode = 2;
+			if (context)
+				GpuProfiler::Shared().Suspend(true);
+			const uint64_t before = FrameStats::Shared().Current().total.triangles;
+			drawScene();
+			referenceTriangles = FrameStats::Shared().Current().total.triangles - before;
+			backend->ReadPixels(referencePixels);
+			FrameStats::Shared().Discard();
+			GLDispatch::Shared().Discard();
+			if (context)
+				GpuProfiler::Shared().Suspend(false);
+			mode = selected;
+			referenceMs += (Profiler::Now() - referenceStart) / 1e6;
+		}
+		const uint64_t trianglesBefore = FrameStats::Shared().Current().total.triangles;
+		drawScene();
+		if (lodError) {
+			backend->ReadPixels(lodPixels);
+			lodError->Frame(currentTime, FrameStats::Shared().Current().total.triangles - trianglesBefore, referenceTriangles,
+				comparer.Compare(&referencePixels[0], &lodPixels[0], width, height));
+		}
+
+		// Display Title, over the scene
+		if (scene.title && textProgram)
+			RenderText(*textProgram, "The Level of Detail Algorithm", 310.0f, 840.0f, 2.0f, glm::vec3(1.0f, 0.2f, 0.2f));
+
+		// Final frame of a replay, hashed before the HUD's timings make every run differ
+		if (replaying && replay.Finished()) {
+			backend->ReadPixels(finalPixels);
+			finalHash = HashPixels(finalPixels);
+		}
+		if (capture)
+			capture->Capture();
+
+		// Controls, last frame's draw statistics and GPU pass times, over the scene
+		if (textProgram && scene.hud) {
+			RenderText(*textProgram, getMode(), 5.0f, 5.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f)); // Render text: Mode
+			RenderText(*textProgram, "(C) Change Camera Position", 5.0f, 30.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f)); // Display Camera Position Instruction
+			RenderText(*textProgram, wireframe ? "(W) Wireframe Mode: ON" : "(W) Wireframe Mode: OFF", 5.0f, 55.0f, 0.5f, glm::vec3(1.0f, 0.0f, 0.0f));
+			drawFrameStats(*textProgram, 5.0f);
+			drawGpuPasses(*textProgram, 5.0f);
+		}
+		else if (textProgram && scene.showcase) {
+			// Display Level names
+			RenderText(*textProgram, "L0              L1               L2               L3               L4", 280.0f, 350.0f, 1.3f, glm::vec3(1.0f, 0.0f, 0.0f));
+		}
+
+		// CPU zone timings over everything else
+		if (textProgram && showProfiler)
+			drawProfiler(*textProgram);
+
+		// Read back GPU passes that finished a couple of frames ago
+		if (context) {
+			if (timedPerVertex != perVertexNormals) {
+				GpuProfiler::Shared().Reset();
+				timedPerVertex = perVertexNormals;
 			}
+			GpuProfiler::Shared().EndFrame();
+		}
+
+		// Close this frame's draw statistics, export the series on request
+		FrameStats::Shared().EndFrame(currentTime);
+		if (statsRequested) {
+			FrameStats::Shared().WriteSeries("../stats.csv");
+			statsRequested = false;
 		}
-		if (currentTime > 105 & currentTime < 106)
-			cameraMovePos1();
 
 		// Swap Buffer
-		glfwSwapBuffers(window);
+		if (context) {
+			PROFILE_ZONE("Swap");
+			context->Present();
+		}
+
+		// Stop once the benchmark's frame or time budget is spent, or at the timeline's end without one
+		renderedFrames++;
+		if (report) {
+			report->Frame(FrameStats::Shared().Last());
+			if ((options.frames > 0 && renderedFrames >= options.frames) || (options.seconds > 0.0 && report->Seconds() >= options.seconds))
+				break;
+			if (replaying) {
+				if (replay.Finished())
+					break;
+			}
+			else if (options.frames <= 0 && options.seconds <= 0.0 && timeline.End() >= 0.0 && currentTime >= timeline.End())
+				break;
+		}
+	}
+
+	// Engine submission cost, what each frame handed the dispatch
+	GLDispatch::Shared().Finish();
+	if (GLDispatch::Shared().Mode() != DISPATCH_DIRECT && GLDispatch::Shared().Frames() > 0) {
+		const DispatchCounters& total = GLDispatch::Shared().Total();
+		const double frames = (double)GLDispatch::Shared().Frames();
+		std::cout << "GL dispatch: " << std::fixed << std::setprecision(1) << total.commands / frames << " commands, "
+			<< total.bytes / frames / 1024.0 << " KB per frame" << std::endl;
+		if (report) {
+			report->SetMetric("gl_commands_per_frame", total.commands / frames);
+			report->SetMetric("gl_command_bytes_per_frame", total.bytes / frames);
+		}
+	}
+
+	// Frames still in flight are written before exiting
+	if (capture) {
+		capture->Finish();
+		std::cout << "Frame capture: " << capture->Frames() << " frames to " << options.capture << ", " << std::fixed << std::setprecision(3)
+			<< capture->AverageMs() << " ms per frame on the render thread, " << capture->Stalls() << " stalls, " << capture->Failures() << " failed" << std::endl;
+		if (report)
+			report->SetMetric("capture_ms_per_frame", capture->AverageMs());
+	}
+
+	// Quality against cost of this run's distance table
+	if (lodError && lodError->Frames() > 0) {
+		std::cout << "LOD error: " << lodError->Frames() << " frames, distances " << LODDistances[0] << "," << LODDistances[1] << "," << LODDistances[2] << ","
+			<< LODDistances[3] << "," << LODDistances[4] << std::fixed << std::setprecision(3) << ", PSNR mean " << lodError->MeanPSNR() << " dB worst " << lodError->WorstPSNR()
+			<< " dB, SSIM mean " << lodError->MeanSSIM() << " worst " << lodError->WorstSSIM() << ", max error " << lodError->WorstMaxError()
+			<< ", " << lodError->TriangleRatio() * 100.0 << "% of LOD0 triangles, reference render " << referenceMs / lodError->Frames() << " ms per frame" << std::endl;
+		if (report) {
+			report->SetMetric("lod_psnr_mean", lodError->MeanPSNR());
+			report->SetMetric("lod_psnr_worst", lodError->WorstPSNR());
+			report->SetMetric("lod_ssim_mean", lodError->MeanSSIM());
+			report->SetMetric("lod_ssim_worst", lodError->WorstSSIM());
+			report->SetMetric("lod_max_error", lodError->WorstMaxError());
+			report->SetMetric("lod_triangle_ratio", lodError->TriangleRatio());
+
+			// Frame times include the reference render, this is how much of them it was
+			report->SetMetric("lod_reference_ms_per_frame", referenceMs / lodError->Frames());
+		}
+	}
+
+	// Program and mesh switches the draw queue's order saved
+	if (glBackend && glBackend->QueueTotals().draws > 0 && renderedFrames > 0) {
+		const DrawQueueStats& queue = glBackend->QueueTotals();
+		const double frames = (double)renderedFrames;
+		std::cout << "Draw queue: " << std::fixed << std::setprecision(1) << queue.draws / frames << " draws, program switches "
+			<< queue.programSwitchesSubmitted / frames << " submitted / " << queue.programSwitchesSorted / frames << " sorted, mesh switches "
+			<< queue.meshSwitchesSubmitted / frames << " submitted / " << queue.meshSwitchesSorted / frames << " sorted per frame" << std::endl;
+		if (report) {
+			report->SetMetric("program_switches_submitted", queue.programSwitchesSubmitted / frames);
+			report->SetMetric("program_switches_sorted", queue.programSwitchesSorted / frames);
+			report->SetMetric("mesh_switches_submitted", queue.meshSwitchesSubmitted / frames);
+			report->SetMetric("mesh_switches_sorted", queue.meshSwitchesSorted / frames);
+		}
 	}
 
-	glfwTerminate();
+	// Draws the static field's proxies saved
+	if (hlod.Proxies() > 0 && renderedFrames > 0) {
+		std::cout << "HLOD: " << std::fixed << std::setprecision(1) << hlod.ProxiesPerFrame() << " proxy draws for "
+			<< hlod.BodiesReplacedPerFrame() << " bodies per frame" << std::endl;
+		if (report) {
+			report->SetMetric("hlod_proxies_per_frame", hlod.ProxiesPerFrame());
+			report->SetMetric("hlod_bodies_replaced_per_frame", hlod.BodiesReplacedPerFrame());
+			report->SetMetric("hlod_proxy_triangles", (double)hlod.ProxyTriangles());
+
+			// Builds before the first frame aren't in the frame times, any a later static field needed are
+			report->SetMetric("hlod_build_ms_untimed", hlodUntimedMs);
+			if (hlodTimedMs > 0.0)
+				report->SetMetric("hlod_build_ms_in_frames", hlodTimedMs);
+		}
+	}
+
+	if (replaying)
+		std::cout << "Replay: " << renderedFrames << " of " << replay.Frames() << " frames, final frame hash " << finalHash << std::endl;
+	// Software throughput over every frame, vertex setup and tiles together
+	if (rasterizer) {
+		std::cout << "Software rasterizer: " << std::fixed << std::setprecision(0) << rasterizer->TrianglesPerSecond() << " triangles/s, "
+			<< rasterizer->PixelsPerSecond() << " pixels/s (" << rasterizer->Description() << ")" << std::endl;
+		if (report) {
+			report->SetMetric("triangles_per_second", rasterizer->TrianglesPerSecond());
+			report->SetMetric("pixels_per_second", rasterizer->PixelsPerSecond());
+		}
+	}
+	if (report) {
+		report->SetFrameHash(finalHash);
+		report->Write(options.report);
+	}
 	return 0;
 }
 
@@ -627,47 +1472,36 @@ int main()
 /// --------------------------------------------------------------------------------------------------------
 void RenderText(Shader &s, std::string text, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 color)
 {
+	// Still compiling, skip the text this frame
+	if (s.Program == 0)
+		return;
+	PROFILE_ZONE("Text");
+	GpuProfiler::Shared().Begin("Text");
+
 	// Activate corresponding render state	
+	GLDispatch& gl = GLDispatch::Shared();
 	s.Use();
-	glUniform3f(glGetUniformLocation(s.Program, "textColor"), color.x, color.y, color.z);
-	glActiveTexture(GL_TEXTURE0);
-	glBindVertexArray(VAO);
+	gl.Uniform3f(glGetUniformLocation(s.Program, "textColor"), color.x, color.y, color.z);
+	gl.ActiveTexture(GL_TEXTURE0);
+	gl.BindVertexArray(VAO);
+	gl.BindBuffer(GL_ARRAY_BUFFER, VBO);
+
+	// Lay the whole line out, then one upload and draw per glyph
+	static std::vector<GlyphQuad> quads;
+	quads.clear();
+	LayoutText(Characters, text, x, y, scale, quads);
 
-	// Iterate through all characters
-	std::string::const_iterator c;
-	for (c = text.begin(); c != text.end(); c++)
+	for (size_t i = 0; i < quads.size(); i++)
 	{
-		Character ch = Characters[*c];
-
-		GLfloat xpos = x + ch.Bearing.x * scale;
-		GLfloat ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
-
-		GLfloat w = ch.Size.x * scale;
-		GLfloat h = ch.Size.y * scale;
-		// Update VBO for each character
-		GLfloat vertices[6][4] = {
-			{ xpos,     ypos + h,   0.0, 0.0 },
-			{ xpos,     ypos,       0.0, 1.0 },
-			{ xpos + w, ypos,       1.0, 1.0 },
-
-			{ xpos,     ypos + h,   0.0, 0.0 },
-			{ xpos + w, ypos,       1.0, 1.0 },
-			{ xpos + w, ypos + h,   1.0, 0.0 }
-		};
 		// Render glyph texture over quad
-		glBindTexture(GL_TEXTURE_2D, ch.TextureID);
+		gl.BindTexture(GL_TEXTURE_2D, quads[i].TextureID);
 		// Update content of VBO memory
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		gl.BufferSubData(GL_ARRAY_BUFFER, 0, sizeof(quads[i].vertices), quads[i].vertices);
 		// Render quad
-		glDrawArrays(GL_TRIANGLES, 0, 6);
-		// Now advance cursors for next glyph (note that advance is number of 1/64 pixels)
-		x += (ch.Advance >> 6) * scale; // Bitshift by 6 to get value in pixels (2^6 = 64)
+		gl.DrawArrays(GL_TRIANGLES, 0, 6);
+		FrameStats::Shared().Draw(6, 6, 1, -1);
 	}
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
-	
+	GpuProfiler::Shared().End();
 }
 
 
@@ -678,8 +1512,11 @@ void RenderText(Shader &s, std::string text, GLfloat x, GLfloat y, GLfloat scale
 // Is called whenever a key is pressed/released via GLFW
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mode)
 {
+	// Kept for --record, replays call this with the logged keys
+	recorder.Key(key, action);
+
 	// EXIT if escape key pressed
-	if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+	if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS && window)
 		glfwSetWindowShouldClose(window, GL_TRUE);
 
 	// Set currently pressed keys
@@ -697,16 +1534,16 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 // Analyse Pressed keys
 void key_triggered() {
 	if (keys[GLFW_KEY_RIGHT]) {
-		if (mode < 7)
+		if (mode < 8)
 			mode += 1; // Set Object Mode
-		if(mode >= 7)
+		if(mode >= 8)
 			mode = 0;
 	}
 	if (keys[GLFW_KEY_LEFT]) {
 		if (mode >= 0)
 			mode -= 1; // Set Object Mode
 		if (mode < 0)
-			mode = 6;
+			mode = 7;
 	}
 	if (keys[GLFW_KEY_C]) {
 		camPos++;
@@ -722,6 +1559,18 @@ void key_triggered() {
 	if (keys[GLFW_KEY_W]) {
 		wireframe = !wireframe;
 	}
+	if (keys[GLFW_KEY_P]) {
+		showProfiler = !showProfiler;
+	}
+	if (keys[GLFW_KEY_T]) {
+		traceRequested = true; // Written at the end of the frame
+	}
+	if (keys[GLFW_KEY_E]) {
+		statsRequested = true; // Written at the end of the frame
+	}
+	if (keys[GLFW_KEY_N]) {
+		perVertexNormals = !perVertexNormals; // Compare normal matrix paths
+	}
 }
 
 /// --------------------------------------------------------------------------------------------------------
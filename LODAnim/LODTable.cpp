@@ -0,0 +1,113 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: LOD Table, per-asset LOD switch distances loaded from a file, written by the LOD tuner
+
+// Std. Includes
+#include <cfloat>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+// custom Includes
+#include "LODTable.h"
+
+
+bool LODTable::Load(const std::string& path)
+{
+	std::ifstream file(path.c_str());
+	if (!file) {
+		std::cout << "ERROR::LOD TABLE:: Could not read " << path << std::endl;
+		return false;
+	}
+
+	entries.clear();
+	std::string line;
+	int number = 0;
+	while (std::getline(file, line)) {
+		number++;
+
+		// Everything after # is a comment
+		size_t comment = line.find('#');
+		if (comment != std::string::npos)
+			line.erase(comment);
+		if (line.find_first_not_of(" \t\r") == std::string::npos)
+			continue;
+
+		// Tables from before the impostor level have no d4
+		Entry entry;
+		std::istringstream words(line);
+		std::string rest;
+		bool valid = (bool)(words >> entry.asset >> entry.table >> entry.distances[0] >> entry.distances[1] >> entry.distances[2] >> entry.distances[3]);
+		if (valid && !(words >> entry.distances[4])) {
+			entry.distances[4] = FLT_MAX;
+			words.clear();
+		}
+		valid = valid && !(words >> rest) && (entry.table == "normal" || entry.table == "exaggerated") && ValidDistances(entry.distances, 5);
+		if (!valid) {
+			std::cout << "ERROR::LOD TABLE:: " << path << ":" << number << ": Could not understand \"" << line << "\"" << std::endl;
+			return false;
+		}
+		Set(entry.asset, entry.table, entry.distances);
+	}
+	return true;
+}
+
+bool LODTable::ValidDistances(const float* distances, int count)
+{
+	if (count < 1 || !(distances[0] > 0.0f))
+		return false;
+	for (int i = 1; i < count; i++) {
+		if (!(distances[i] >= distances[i - 1]))
+			return false;
+	}
+	return true;
+}
+
+bool LODTable::Write(const std::string& path, const std::string& comment) const
+{
+	std::ofstream file(path.c_str(), std::ios::trunc);
+	if (!file) {
+		std::cout << "ERROR::LOD TABLE:: Could not write " << path << std::endl;
+		return false;
+	}
+
+	std::istringstream lines(comment);
+	std::string line;
+	while (std::getline(lines, line))
+		file << "# " << line << "\n";
+	file << "# <asset> normal|exaggerated <d0> <d1> <d2> <d3> [<d4>]\n\n";
+	for (const Entry& entry : entries) {
+		file << entry.asset << " " << entry.table;
+		for (int i = 0; i < 5 && entry.distances[i] < FLT_MAX; i++)
+			file << " " << entry.distances[i];
+		file << "\n";
+	}
+	return true;
+}
+
+bool LODTable::Get(const std::string& asset, const std::string& table, float distances[5]) const
+{
+	for (const Entry& entry : entries) {
+		if (entry.asset == asset && entry.table == table) {
+			std::copy(entry.distances, entry.distances + 5, distances);
+			return true;
+		}
+	}
+	return false;
+}
+
+void LODTable::Set(const std::string& asset, const std::string& table, const float distances[5])
+{
+	for (Entry& entry : entries) {
+		if (entry.asset == asset && entry.table == table) {
+			std::copy(distances, distances + 5, entry.distances);
+			return;
+		}
+	}
+	Entry entry;
+	entry.asset = asset;
+	entry.table = table;
+	std::copy(distances, distances + 5, entry.distances);
+	entries.push_back(entry);
+}
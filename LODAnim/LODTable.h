@@ -0,0 +1,43 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: LOD Table, per-asset LOD switch distances loaded from a file, written by the LOD tuner
+
+// Std. Includes
+#include <string>
+#include <vector>
+
+// Distance tables of each asset, one per LOD mode that selects by distance
+//
+// File layout, one table per line, # starts a comment:
+//   <asset> normal|exaggerated <d0> <d1> <d2> <d3> [<d4>]
+// A body is drawn at level i below di, and as an impostor beyond d4. Without d4 it never is
+class LODTable
+{
+public:
+	// Read a table file, false and an error on bad input
+	bool Load(const std::string& path);
+
+	// Write every table under a comment, false and an error if the file can't be written
+	bool Write(const std::string& path, const std::string& comment) const;
+
+	// Copy an asset's table into distances, false if the file has none for it
+	bool Get(const std::string& asset, const std::string& table, float distances[5]) const;
+
+	// Add or replace an asset's table
+	void Set(const std::string& asset, const std::string& table, const float distances[5]);
+
+	// Positive and never decreasing, equal distances skip a level. Tables, --distances and the tuner's output all
+	// follow this rule
+	static bool ValidDistances(const float* distances, int count);
+
+private:
+	struct Entry {
+		std::string asset;
+		std::string table;
+		float distances[5];
+	};
+
+	/*  Table data  */
+	std::vector<Entry> entries;
+};
@@ -0,0 +1,120 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: LOD Tuner, renders every level of a model at sampled distances and finds where each level can take over
+
+// Std. Includes
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+
+// GL Includes
+#include <glm/gtc/matrix_transform.hpp>
+
+// custom Includes
+#include "LODTuner.h"
+#include "Profiler.h"
+
+// Rotations each distance is rendered at, so one lucky silhouette can't pass a level
+static const float ANGLES[] = { 0.0f, 50.0f, 100.0f };
+static const glm::vec3 AXIS(0.28f, 0.93f, 0.24f);
+
+// Background of the tuning renders, anything else is covered by the body
+static const glm::vec4 CLEAR(0.0f, 0.0f, 0.0f, 1.0f);
+
+
+LODTuner::LODTuner(RenderBackend& backend, int width, int height, glm::mat4 projection) :
+	backend(backend), width(width), height(height)
+{
+	// Camera at the origin looking down -z, lit from above and behind it like the sun lights the near orbits
+	frame.view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	frame.projection = projection;
+	frame.lightPos = glm::vec4(0.0f, 20.0f, 10.0f, 1.0f);
+	frame.lightColour = glm::vec4(1.0f, 0.9f, 0.8f, 1.0f);
+	frame.viewPos = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+void LODTuner::Measure(std::vector<Model>& levels, const unsigned variants[5], float nearest, float farthest, int count)
+{
+	PROFILE_ZONE("LOD Tuning");
+	samples.clear();
+	std::vector<unsigned char> reference, image;
+	for (int i = 0; i < count; i++) {
+		LODSample sample;
+		sample.distance = nearest * std::pow(farthest / nearest, count > 1 ? (float)i / (count - 1) : 0.0f);
+		for (int level = 0; level < 5; level++)
+			sample.psnr[level] = PSNR_IDENTICAL;
+
+		const glm::vec3 position(0.0f, 0.0f, -sample.distance);
+		for (float angle : ANGLES) {
+			render(levels[0], variants[0], 0, position, angle, reference);
+			for (int level = 1; level < 5; level++) {
+				render(levels[level], variants[level], level, position, angle, image);
+				sample.psnr[level] = std::min(sample.psnr[level], compareCovered(reference, image));
+			}
+		}
+		samples.push_back(sample);
+	}
+}
+
+void LODTuner::SwitchDistances(double targetPSNR, float distances[4]) const
+{
+	for (int level = 1; level < 5; level++) {
+		// Walk in from the farthest sample while the level still holds up
+		float switchAt = samples.empty() ? 0.0f : samples.back().distance;
+		for (size_t i = samples.size(); i-- > 0;) {
+			if (samples[i].psnr[level] < targetPSNR)
+				break;
+			switchAt = samples[i].distance;
+		}
+
+		// A coarser level can't take over before a finer one
+		distances[level - 1] = level > 1 ? std::max(switchAt, distances[level - 2]) : switchAt;
+	}
+}
+
+void LODTuner::render(Model& model, unsigned variant, int level, glm::vec3 position, float angle, std::vector<unsigned char>& pixels)
+{
+	model.transformR(position, glm::normalize(AXIS), angle, false, 0.0f);
+	model.changeColour(glm::vec3(1.0f));
+
+	backend.BeginFrame(frame, CLEAR);
+	backend.BeginPass("Tuning");
+	model.Draw(backend, variant, level);
+	backend.EndPass();
+	backend.EndFrame();
+	backend.ReadPixels(pixels);
+}
+
+double LODTuner::compareCovered(const std::vector<unsigned char>& reference, const std::vector<unsigned char>& image)
+{
+	// Box around every pixel either render drew, the first pixel is background in both
+	int left = width, right = -1, bottom = height, top = -1;
+	for (int y = 0; y < height; y++) {
+		const unsigned char* a = &reference[(size_t)y * width * 4];
+		const unsigned char* b = &image[(size_t)y * width * 4];
+		for (int x = 0; x < width; x++) {
+			if (std::memcmp(a + x * 4, &reference[0], 3) != 0 || std::memcmp(b + x * 4, &reference[0], 3) != 0) {
+				left = std::min(left, x);
+				right = std::max(right, x);
+				bottom = std::min(bottom, y);
+				top = std::max(top, y);
+			}
+		}
+	}
+	if (right < 0)
+		return PSNR_IDENTICAL;
+
+	// At least one SSIM block across, inside the frame
+	const int cropWidth = std::min(std::max(right - left + 1, 8), width), cropHeight = std::min(std::max(top - bottom + 1, 8), height);
+	left = std::min(left, width - cropWidth);
+	bottom = std::min(bottom, height - cropHeight);
+
+	referenceCrop.resize((size_t)cropWidth * cropHeight * 4);
+	imageCrop.resize(referenceCrop.size());
+	for (int y = 0; y < cropHeight; y++) {
+		const size_t from = ((size_t)(bottom + y) * width + left) * 4, to = (size_t)y * cropWidth * 4;
+		std::copy(&reference[from], &reference[from] + cropWidth * 4, &referenceCrop[to]);
+		std::copy(&image[from], &image[from] + cropWidth * 4, &imageCrop[to]);
+	}
+	return comparer.Compare(&referenceCrop[0], &imageCrop[0], cropWidth, cropHeight).psnr;
+}
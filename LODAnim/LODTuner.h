@@ -0,0 +1,53 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: LOD Tuner, renders every level of a model at sampled distances and finds where each level can take over
+
+// Std. Includes
+#include <vector>
+
+// GL Includes
+#include <glm/glm.hpp>
+
+// custom Includes
+#include "Model.h"
+#include "RenderBackend.h"
+#include "ImageError.h"
+
+// One sampled distance: each level's worst PSNR against level 0 over the sampled rotations
+struct LODSample {
+	float distance;
+	double psnr[5];    // psnr[0] is always PSNR_IDENTICAL
+};
+
+class LODTuner
+{
+public:
+	// Renders through backend at width x height, with the scene's projection so bodies cover the same pixels
+	LODTuner(RenderBackend& backend, int width, int height, glm::mat4 projection);
+
+	// Render levels[0..4] at count distances spaced evenly in log between nearest and farthest. Error is only
+	// measured over the pixels either render covers, empty background would hide it
+	void Measure(std::vector<Model>& levels, const unsigned variants[5], float nearest, float farthest, int count);
+
+	// Smallest sampled distance for each level beyond which it never falls below target PSNR, never decreasing.
+	// A level that never gets there switches at the farthest sample
+	void SwitchDistances(double targetPSNR, float distances[4]) const;
+
+	const std::vector<LODSample>& Samples() const { return samples; }
+
+private:
+	// Draw one level alone and read it back
+	void render(Model& model, unsigned variant, int level, glm::vec3 position, float angle, std::vector<unsigned char>& pixels);
+
+	// PSNR of image against reference over the box both cover, identical when neither covers a pixel
+	double compareCovered(const std::vector<unsigned char>& reference, const std::vector<unsigned char>& image);
+
+	/*  Tuner data  */
+	RenderBackend& backend;
+	int width, height;
+	FrameUniforms frame;
+	ImageComparer comparer;
+	std::vector<unsigned char> referenceCrop, imageCrop;
+	std::vector<LODSample> samples;
+};
@@ -0,0 +1,59 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Level of Detail, distance checks and orbit positions shared by the scene and the benchmarks
+
+// Std. Includes
+#include <cmath>
+
+// custom Includes
+#include "LevelOfDetail.h"
+
+
+float EuclideanDistance(glm::vec3 modelLoc, glm::vec3 referenceLoc) {
+	float sum = 0;
+	for (int i = 0; i < 3; i++) {
+		sum += pow((referenceLoc[i] - modelLoc[i]), 2);
+	}
+	return sqrt(sum);
+}
+
+int CheckLevel(glm::vec3 objectT, glm::vec3 referenceLoc, float Distances[]) {
+	float distance = EuclideanDistance(objectT, referenceLoc);
+
+	int level;
+	if (distance < Distances[0]) {
+		level = 0;
+	}
+	else if (distance < Distances[1]) {
+		level = 1;
+	}
+	else if (distance < Distances[2]) {
+		level = 2;
+	}
+	else if (distance < Distances[3]) {
+		level = 3;
+	}
+	else if (distance < Distances[4]) {
+		level = 4;
+	}
+	else {
+		level = IMPOSTOR_LEVEL;
+	}
+	return level;
+}
+
+void ImpostorQuad(float radius, std::vector<Vertex>& vertices, std::vector<GLuint>& indices) {
+	// Counter-clockwise from the bottom left, the vertex stage turns it to face the eye
+	const float corners[4][2] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }, { -1.0f, 1.0f } };
+	vertices.resize(4);
+	for (int i = 0; i < 4; i++) {
+		vertices[i].Position = glm::vec3(corners[i][0] * radius, corners[i][1] * radius, 0.0f);
+		vertices[i].Normal = glm::vec3(0.0f, 0.0f, 1.0f);
+	}
+	const GLuint quad[] = { 0, 1, 2, 0, 2, 3 };
+	indices.assign(quad, quad + 6);
+}
+
+glm::vec3 OrbitPosition(float time, float orbitRadius, float orbitSpeed, float height) {
+	return glm::vec3(sin(time / orbitSpeed) * orbitRadius, cos(time / orbitSpeed) * orbitRadius, height);
+}
@@ -0,0 +1,30 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Level of Detail, distance checks and orbit positions shared by the scene and the benchmarks
+
+// Std. Includes
+#include <vector>
+
+// GL Includes
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+// custom Includes
+#include "Vertex.h"
+
+// Body levels: meshes LOD0 to LOD4, then the ray-cast sphere impostor
+const int LOD_LEVELS = 6;
+const int IMPOSTOR_LEVEL = 5;
+
+// Calculate the Euclidean Distance between 2 Positions
+float EuclideanDistance(glm::vec3 modelLoc, glm::vec3 referenceLoc);
+
+// LOD level of a model at objectT seen from referenceLoc, Distances holds the 5 level thresholds
+int CheckLevel(glm::vec3 objectT, glm::vec3 referenceLoc, float Distances[]);
+
+// Two triangle quad an IMPOSTOR program draws a sphere of radius on, corners at +-radius facing +z
+void ImpostorQuad(float radius, std::vector<Vertex>& vertices, std::vector<GLuint>& indices);
+
+// Position on a circular orbit about the origin, speed in seconds per radian
+glm::vec3 OrbitPosition(float time, float orbitRadius, float orbitSpeed, float height = 0.0f);
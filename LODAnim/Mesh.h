@@ -20,17 +20,13 @@
 
 // custom Includes
 #include "Shader.h"
+#include "Vertex.h"
+#include "GeometryArena.h"
+#include "FrameStats.h"
+#include "GLDispatch.h"
 
 using namespace std;
 
-
-struct Vertex {
-	// Position
-	glm::vec3 Position;
-	// Normal
-	glm::vec3 Normal;
-};
-
 class Mesh {
 public:
 	/*  Mesh Data  */
@@ -48,46 +44,46 @@ public:
 		this->setupMesh();
 	}
 
-	// Render the mesh
-	void Draw(Shader shader)
+	// Render the mesh, level only tags the draw in the frame statistics
+	void Draw(int level = -1) const
+	{
+		// Draw mesh from its slice of the shared arena, every mesh uses the same VAO
+		GeometryArena::Shared().Bind();
+		GLDispatch::Shared().DrawElementsBaseVertex(GL_TRIANGLES, this->range.indexCount, GL_UNSIGNED_INT,
+			this->range.firstIndex * sizeof(GLuint), this->range.baseVertex);
+		FrameStats::Shared().Draw(this->range.indexCount, this->range.vertexCount, 1, level);
+	}
+
+	// Render count copies of the mesh, the shader picks per-copy data with gl_InstanceID
+	void DrawInstanced(GLsizei count, int level = -1) const
 	{
-		// Draw mesh
-		glBindVertexArray(this->VAO);
-		glDrawElements(GL_TRIANGLES, this->indices.size(), GL_UNSIGNED_INT, 0);
-		glBindVertexArray(0);
+		GeometryArena::Shared().Bind();
+		GLDispatch::Shared().DrawElementsInstancedBaseVertex(GL_TRIANGLES, this->range.indexCount, GL_UNSIGNED_INT,
+			this->range.firstIndex * sizeof(GLuint), count, this->range.baseVertex);
+		FrameStats::Shared().Draw(this->range.indexCount, this->range.vertexCount, count, level);
+	}
+
+	// Where the mesh starts in the arena, what draw sort keys group meshes by
+	GLuint FirstIndex() const { return this->range.firstIndex; }
+
+	// Give the mesh's slice back to the arena, it can't be drawn afterwards
+	void Release()
+	{
+		if (!GeometryArena::CPUOnly())
+			GeometryArena::Shared().Free(this->range);
 	}
 
 private:
 	/*  Render data  */
-	GLuint VAO, VBO, EBO;
+	ArenaRange range;
 
 	/*  Functions    */
-	// Initializes all the buffer objects/arrays
+	// Copies the mesh into the shared geometry arena, CPU only meshes stay in vertices / indices
 	void setupMesh()
 	{
-		// Create buffers/arrays
-		glGenVertexArrays(1, &this->VAO);
-		glGenBuffers(1, &this->VBO);
-		glGenBuffers(1, &this->EBO);
-
-		glBindVertexArray(this->VAO);
-
-		// Load data into vertex buffers
-		glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
-		glBufferData(GL_ARRAY_BUFFER, this->vertices.size() * sizeof(Vertex), &this->vertices[0], GL_STATIC_DRAW);
-
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->EBO);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, this->indices.size() * sizeof(GLuint), &this->indices[0], GL_STATIC_DRAW);
-
-		// Set the vertex attribute pointers
-		// Vertex Positions
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)0);
-		// Vertex Normals
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, Normal));
-
-		glBindVertexArray(0);
+		if (GeometryArena::CPUOnly())
+			return;
+		this->range = GeometryArena::Shared().Allocate(this->vertices, this->indices);
 	}
 };
 
@@ -13,6 +13,7 @@
 #include <iostream>
 #include <map>
 #include <vector>
+#include <algorithm>
 
 // GL Includes
 #include <GL/glew.h> // Contains all the necessery OpenGL includes
@@ -25,9 +26,18 @@
 // custom Includes
 #include "Mesh.h"
 #include "Shader.h"
+#include "UniformRing.h"
+#include "ShaderVariants.h"
+#include "RenderBackend.h"
 
 using namespace std;
 
+// Vertices and indices of one mesh as read from file, before they go to the GPU
+struct MeshData {
+	vector<Vertex> vertices;
+	vector<GLuint> indices;
+};
+
 class Model
 {
 public:
@@ -35,102 +45,159 @@ public:
 	// Constructor, expects a filepath to a 3D model.
 	Model(string path)
 	{
+		this->object.colour = glm::vec4(1.0f);
 		this->loadModel(path);
 	}
 
-	// Draws the model, and thus all its meshes
-	void Draw(Shader shader)
+	// Constructor, a model of one mesh made in code rather than read from file
+	Model(const MeshData& data)
+	{
+		this->object.colour = glm::vec4(1.0f);
+		this->meshes.push_back(Mesh(data.vertices, data.indices));
+	}
+
+	// Draws the model through a backend with the program of a set of ShaderVariant bits
+	// Level is the LOD level the model stands for in the draw statistics, -1 for anything else
+	void Draw(RenderBackend& backend, unsigned variant, int level = -1)
+	{
+		backend.Draw(this->meshes[0], variant, &this->object, 1, level);
+	}
+
+	// Draws one copy of the model per entry in objects, with a single draw call per MAX_INSTANCES
+	void DrawInstanced(RenderBackend& backend, unsigned variant, vector<ObjectUniforms>& objects, int level = -1)
+	{
+		if (!objects.empty())
+			backend.Draw(this->meshes[0], variant | VARIANT_INSTANCED, &objects[0], objects.size(), level);
+	}
+
+	// File the model was read from, empty for one made in code
+	const string& Path() const
+	{
+		return this->path;
+	}
+
+	// Meshes as loaded, e.g. to bake
+	const vector<Mesh>& Meshes() const
+	{
+		return this->meshes;
+	}
+
+	// Farthest vertex of the first mesh from the model origin, what an impostor of it is sized by
+	float Radius() const
 	{
-			this->meshes[0].Draw(shader);
+		float radius = 0.0f;
+		for (const Vertex& vertex : this->meshes[0].vertices)
+			radius = std::max(radius, glm::length(vertex.Position));
+		return radius;
+	}
+
+	// Matrix and colour set by the last transform / changeColour, e.g. to collect instances
+	const ObjectUniforms& Object() const
+	{
+		return this->object;
 	}
 
 	// Change the colour applied to all vertices
-	void changeColour(Shader shader, glm::vec3 Colour) {
-		GLint colourLoc = glGetUniformLocation(shader.Program, "myColour");
-		glUniform3f(colourLoc, Colour[0], Colour[1], Colour[2]);
+	void changeColour(glm::vec3 Colour) {
+		this->object.colour = glm::vec4(Colour, 1.0f);
 	}
 
 	// Change the scale of the Model
-	void scale(Shader shader, glm::vec3 scale) {
+	void scale(glm::vec3 scale) {
 		glm::mat4 model;
 		model = glm::scale(model, scale);
-		GLint modelLoc = glGetUniformLocation(shader.Program, "model");
-		glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+		this->object.model = model;
 	}
 
 	// Change the rotation of the Model
-	void rotate(Shader shader, glm::vec3 rotationVector, float rotationAmount) {
+	void rotate(glm::vec3 rotationVector, float rotationAmount) {
 		glm::mat4 model;
 		model = glm::rotate(model, rotationAmount, rotationVector);
-		GLint modelLoc = glGetUniformLocation(shader.Program, "model");
-		glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+		this->object.model = model;
 	}
 
 	// Change the rotation and scale the Model
-	void rotateS(Shader shader, glm::vec3 rotationVector, float rotationAmount, glm::vec3 scale) {
+	void rotateS(glm::vec3 rotationVector, float rotationAmount, glm::vec3 scale) {
 		glm::mat4 model;
 		model = glm::rotate(model, rotationAmount, rotationVector);
 		model = glm::scale(model, scale);
-		GLint modelLoc = glGetUniformLocation(shader.Program, "model");
-		glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+		this->object.model = model;
 	}
 
 	// Transform the Model
-	void transform(Shader shader, glm::vec3 transform) {
+	void transform(glm::vec3 transform) {
 		glm::mat4 model;
 		model = glm::translate(model, transform);
-		GLint modelLoc = glGetUniformLocation(shader.Program, "model");
-		glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+		this->object.model = model;
 	}
 
-	// Transform and Rotate the Model
-	void transformR(Shader shader, glm::vec3 transform, glm::vec3 rotationVector, float rotationAmount, bool continuousRotate) {	
+	// Transform and Rotate the Model, a continuous rotation turns rotationAmount degrees per second of time
+	void transformR(glm::vec3 transform, glm::vec3 rotationVector, float rotationAmount, bool continuousRotate, float time) {	
+		this->object.model = BuildTransformR(transform, rotationVector, rotationAmount, continuousRotate, time);
+	}
+
+	// Model matrix of transformR, without touching any model
+	static glm::mat4 BuildTransformR(glm::vec3 transform, glm::vec3 rotationVector, float rotationAmount, bool continuousRotate, float time) {
 		glm::mat4 model;
 		model = glm::translate(model, transform);
 		if (continuousRotate)
-			model = glm::rotate(model, (GLfloat)glfwGetTime() * glm::radians(rotationAmount), rotationVector);
+			model = glm::rotate(model, time * glm::radians(rotationAmount), rotationVector);
 		else
 			model = glm::rotate(model, glm::radians(rotationAmount), rotationVector);
-		GLint modelLoc = glGetUniformLocation(shader.Program, "model");
-		glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+		return model;
+	}
+
+	// Read every mesh of a file with ASSIMP, no GL needed. False and an error if it can't be read
+	static bool Import(string path, vector<MeshData>& meshes)
+	{
+		// Read file via ASSIMP
+		Assimp::Importer importer;
+		const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate);
+		// Check for errors
+		if (!scene || scene->mFlags == AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) // if is Not Zero
+		{
+			cout << "ERROR::ASSIMP:: " << importer.GetErrorString() << endl;
+			return false;
+		}
+
+		// Process ASSIMP's root node recursively
+		processNode(scene->mRootNode, scene, meshes);
+		return true;
 	}
 
 	// Transform, Rotate and Scale the Model
-	void transformRS(Shader shader, glm::vec3 transform, glm::vec3 rotationVector, float rotationAmount, glm::vec3 scale) {
+	void transformRS(glm::vec3 transform, glm::vec3 rotationVector, float rotationAmount, glm::vec3 scale) {
 		glm::mat4 model;
 		model = glm::translate(model, transform);
 		model = glm::rotate(model, rotationAmount, rotationVector);
 		model = glm::scale(model, scale);
-		GLint modelLoc = glGetUniformLocation(shader.Program, "model");
-		glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+		this->object.model = model;
 	}
 private:
 	/*  Model Data  */
 	vector<Mesh> meshes;
+	ObjectUniforms object; // Matrix and colour for the next Draw
+	string path;
 	string directory;
 
 	/*  Functions   */
 	// Loads a model with supported ASSIMP extensions from file and stores the resulting meshes in the meshes vector.
 	void loadModel(string path)
 	{
-		// Read file via ASSIMP
-		Assimp::Importer importer;
-		const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate);
-		// Check for errors
-		if (!scene || scene->mFlags == AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) // if is Not Zero
-		{
-			cout << "ERROR::ASSIMP:: " << importer.GetErrorString() << endl;
+		vector<MeshData> data;
+		if (!Import(path, data))
 			return;
-		}
 		// Retrieve the directory path of the filepath
+		this->path = path;
 		this->directory = path.substr(0, path.find_last_of('/'));
 
-		// Process ASSIMP's root node recursively
-		this->processNode(scene->mRootNode, scene);
+		// Upload each mesh into the geometry arena
+		for (size_t i = 0; i < data.size(); i++)
+			this->meshes.push_back(Mesh(data[i].vertices, data[i].indices));
 	}
 
 	// Processes a node in a recursive fashion. Processes each individual mesh located at the node and repeats this process on its children nodes (if any).
-	void processNode(aiNode* node, const aiScene* scene)
+	static void processNode(aiNode* node, const aiScene* scene, vector<MeshData>& meshes)
 	{
 		// Process each mesh located at the current node
 		for (GLuint i = 0; i < node->mNumMeshes; i++)
@@ -138,23 +205,23 @@ private:
 			// The node object only contains indices to index the actual objects in the scene. 
 			// The scene contains all the data, node is just to keep stuff organized (like relations between nodes).
 			aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-			this->meshes.push_back(this->processMesh(mesh, scene));
+			meshes.push_back(processMesh(mesh, scene));
 		}
 		// After we've processed all of the meshes (if any) we then recursively process each of the children nodes
 		for (GLuint i = 0; i < node->mNumChildren; i++)
 		{
-			this->processNode(node->mChildren[i], scene);
+			processNode(node->mChildren[i], scene, meshes);
 		}
 
 	}
 
-	Mesh processMesh(aiMesh* mesh, const aiScene* scene)
+	static MeshData processMesh(aiMesh* mesh, const aiScene* scene)
 	{
 		// Data to fill
-		vector<Vertex> vertices;
-		vector<GLuint> indices;
+		MeshData data;
 
 		// Walk through each of the mesh's vertices
+		data.vertices.reserve(mesh->mNumVertices);
 		for (GLuint i = 0; i < mesh->mNumVertices; i++)
 		{
 			Vertex vertex;
@@ -169,7 +236,7 @@ private:
 			vector.y = mesh->mNormals[i].y;
 			vector.z = mesh->mNormals[i].z;
 			vertex.Normal = vector;
-			vertices.push_back(vertex);
+			data.vertices.push_back(vertex);
 		}
 		// Now wak through each of the mesh's faces (a face is a mesh its triangle) and retrieve the corresponding vertex indices.
 		for (GLuint i = 0; i < mesh->mNumFaces; i++)
@@ -177,10 +244,10 @@ private:
 			aiFace face = mesh->mFaces[i];
 			// Retrieve all indices of the face and store them in the indices vector
 			for (GLuint j = 0; j < face.mNumIndices; j++)
-				indices.push_back(face.mIndices[j]);
+				data.indices.push_back(face.mIndices[j]);
 		}
 
-		// Return a mesh object created from the extracted mesh data
-		return Mesh(vertices, indices);
+		// Return the extracted mesh data, the Mesh is created from it once it's needed on the GPU
+		return data;
 	}
 };
\ No newline at end of file
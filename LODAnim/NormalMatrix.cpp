@@ -0,0 +1,78 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Normal Matrix, inverse-transpose of the model matrix computed on the CPU
+
+// Std. Includes
+#include <cmath>
+#include <xmmintrin.h>
+
+// custom Includes
+#include "NormalMatrix.h"
+
+// The inverse-transpose of a 3x3 matrix with columns c0, c1, c2 has columns
+// (c1 x c2, c2 x c0, c0 x c1) / det, which is three cross products and a dot
+// rather than the full 4x4 inverse the vertex shader used to run per vertex.
+
+// Scalar path, used for the last count % 4 matrices
+static void computeOne(const glm::mat4& model, NormalMatrix& out)
+{
+	glm::vec3 c0(model[0]), c1(model[1]), c2(model[2]);
+	glm::vec3 r0 = glm::cross(c1, c2), r1 = glm::cross(c2, c0), r2 = glm::cross(c0, c1);
+	float det = glm::dot(c0, r0);
+	float invDet = (det != 0.0f) ? 1.0f / det : 0.0f;
+	out.columns[0] = glm::vec4(r0 * invDet, 0.0f);
+	out.columns[1] = glm::vec4(r1 * invDet, 0.0f);
+	out.columns[2] = glm::vec4(r2 * invDet, 0.0f);
+}
+
+void ComputeNormalMatrices(const glm::mat4* models, NormalMatrix* out, size_t count)
+{
+	size_t i = 0;
+
+	// Four matrices per iteration, one matrix per SSE lane (structure of arrays)
+	for (; i + 4 <= count; i += 4) {
+		const glm::mat4& m0 = models[i], &m1 = models[i + 1], &m2 = models[i + 2], &m3 = models[i + 3];
+		__m128 m[3][3];
+		for (int c = 0; c < 3; c++)
+			for (int r = 0; r < 3; r++)
+				m[c][r] = _mm_set_ps(m3[c][r], m2[c][r], m1[c][r], m0[c][r]);
+
+		// Cofactor columns: r0 = c1 x c2, r1 = c2 x c0, r2 = c0 x c1
+		__m128 cof[3][3];
+		for (int c = 0; c < 3; c++) {
+			const __m128* a = m[(c + 1) % 3];
+			const __m128* b = m[(c + 2) % 3];
+			cof[c][0] = _mm_sub_ps(_mm_mul_ps(a[1], b[2]), _mm_mul_ps(a[2], b[1]));
+			cof[c][1] = _mm_sub_ps(_mm_mul_ps(a[2], b[0]), _mm_mul_ps(a[0], b[2]));
+			cof[c][2] = _mm_sub_ps(_mm_mul_ps(a[0], b[1]), _mm_mul_ps(a[1], b[0]));
+		}
+
+		// det = c0 . (c1 x c2), singular matrices produce a zero normal matrix
+		__m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0][0], cof[0][0]), _mm_mul_ps(m[0][1], cof[0][1])), _mm_mul_ps(m[0][2], cof[0][2]));
+		__m128 nonZero = _mm_cmpneq_ps(det, _mm_setzero_ps());
+		__m128 invDet = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), det), nonZero);
+
+		// Scale and scatter back to each matrix's padded columns
+		float lanes[3][3][4];
+		for (int c = 0; c < 3; c++)
+			for (int r = 0; r < 3; r++)
+				_mm_storeu_ps(lanes[c][r], _mm_mul_ps(cof[c][r], invDet));
+		for (int lane = 0; lane < 4; lane++)
+			for (int c = 0; c < 3; c++)
+				out[i + lane].columns[c] = glm::vec4(lanes[c][0][lane], lanes[c][1][lane], lanes[c][2][lane], 0.0f);
+	}
+
+	for (; i < count; i++)
+		computeOne(models[i], out[i]);
+}
+
+bool IsRigidTransform(const glm::mat4& model)
+{
+	glm::vec3 c0(model[0]), c1(model[1]), c2(model[2]);
+	float s0 = glm::dot(c0, c0), s1 = glm::dot(c1, c1), s2 = glm::dot(c2, c2);
+	const float epsilon = 1e-4f * s0;
+
+	// Equal length, mutually orthogonal columns
+	return fabsf(s0 - s1) < epsilon && fabsf(s0 - s2) < epsilon
+		&& fabsf(glm::dot(c0, c1)) < epsilon && fabsf(glm::dot(c1, c2)) < epsilon && fabsf(glm::dot(c0, c2)) < epsilon;
+}
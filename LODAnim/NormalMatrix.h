@@ -0,0 +1,21 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Normal Matrix, inverse-transpose of the model matrix computed on the CPU
+
+// Std. Includes
+#include <cstddef>
+
+// GL Includes
+#include <glm/glm.hpp>
+
+// std140 mat3, each column padded to a vec4
+struct NormalMatrix {
+	glm::vec4 columns[3];
+};
+
+// Compute transpose(inverse(mat3(model))) for count matrices, four at a time with SSE
+void ComputeNormalMatrices(const glm::mat4* models, NormalMatrix* out, size_t count);
+
+// True if the matrix only rotates, translates and scales uniformly, so mat3(model) already transforms normals
+bool IsRigidTransform(const glm::mat4& model);
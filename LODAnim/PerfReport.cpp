@@ -0,0 +1,169 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Perf Report, frame times and counters of a benchmark run written as JSON
+
+// Std. Includes
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+
+// custom Includes
+#include "PerfReport.h"
+#include "Profiler.h"
+#include "GpuProfiler.h"
+
+// Quoted JSON string, names and driver strings only need quotes and backslashes escaped
+static std::string quote(const std::string& text)
+{
+	std::string quoted = "\"";
+	for (size_t i = 0; i < text.size(); i++) {
+		if (text[i] == '"' || text[i] == '\\')
+			quoted += '\\';
+		quoted += text[i];
+	}
+	return quoted + "\"";
+}
+
+
+std::streambuf* PerfReport::standardOutput = nullptr;
+
+PerfReport::PerfReport(const std::string& backend, const std::string& renderer, int width, int height) :
+	backend(backend), renderer(renderer), width(width), height(height), clockMode("realtime"), clockStep(0.0), started(false), listFrames(false), gpuPasses(true)
+{
+	std::memset(&sum, 0, sizeof(FrameCounters));
+}
+
+void PerfReport::Frame(const FrameCounters& counters)
+{
+	// Frame time is present to present, the first frame only starts the clock
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (!started) {
+		start = previous = now;
+		started = true;
+	}
+	else {
+		frameMs.push_back(std::chrono::duration<double, std::milli>(now - previous).count());
+		previous = now;
+	}
+
+	sum.total.drawCalls += counters.total.drawCalls;
+	sum.total.instances += counters.total.instances;
+	sum.total.triangles += counters.total.triangles;
+	sum.total.vertices += counters.total.vertices;
+	sum.programBinds += counters.programBinds;
+	sum.vertexArrayBinds += counters.vertexArrayBinds;
+	sum.bufferBinds += counters.bufferBinds;
+	sum.textureBinds += counters.textureBinds;
+	sum.uploadBytes += counters.uploadBytes;
+	sum.elidedCalls += counters.elidedCalls;
+}
+
+double PerfReport::Seconds() const
+{
+	return started ? std::chrono::duration<double>(previous - start).count() : 0.0;
+}
+
+void PerfReport::Write(std::ostream& out) const
+{
+	std::vector<double> sorted(frameMs);
+	std::sort(sorted.begin(), sorted.end());
+	double total = 0.0;
+	for (size_t i = 0; i < sorted.size(); i++)
+		total += sorted[i];
+	const size_t n = sorted.size();
+	const double frames = n > 0 ? (double)n : 1.0;
+
+	// Nearest-rank percentile of the sorted frame times
+	struct Percentile { const char* name; double p; };
+	const Percentile percentiles[] = { { "p50", 0.50 }, { "p90", 0.90 }, { "p95", 0.95 }, { "p99", 0.99 } };
+
+	out << std::fixed << std::setprecision(4);
+	out << "{\n";
+	out << "  \"backend\": " << quote(backend) << ",\n";
+	out << "  \"renderer\": " << quote(renderer) << ",\n";
+	out << "  \"width\": " << width << ",\n";
+	out << "  \"height\": " << height << ",\n";
+	out << "  \"clock\": " << quote(clockMode) << ",\n";
+	out << "  \"step\": " << clockStep << ",\n";
+	out << "  \"frames\": " << n << ",\n";
+	out << "  \"seconds\": " << Seconds() << ",\n";
+	out << "  \"fps\": " << (total > 0.0 ? n * 1000.0 / total : 0.0) << ",\n";
+	if (!frameHash.empty())
+		out << "  \"final_frame_hash\": " << quote(frameHash) << ",\n";
+
+	out << "  \"frame_ms\": {";
+	out << " \"min\": " << (n ? sorted.front() : 0.0) << ", \"avg\": " << total / frames;
+	for (const Percentile& p : percentiles)
+		out << ", \"" << p.name << "\": " << (n ? sorted[std::min(n - 1, (size_t)(p.p * n))] : 0.0);
+	out << ", \"max\": " << (n ? sorted.back() : 0.0) << " },\n";
+
+	// In frame order, the first entry is the second frame
+	if (listFrames) {
+		out << "  \"frame_times_ms\": [";
+		for (size_t i = 0; i < frameMs.size(); i++)
+			out << (i ? ", " : " ") << frameMs[i];
+		out << " ],\n";
+	}
+
+	out << "  \"gpu_ms\": {";
+	if (gpuPasses) {
+		const std::vector<GpuPassStats>& passes = GpuProfiler::Shared().Passes();
+		for (size_t i = 0; i < passes.size(); i++)
+			out << (i ? ", " : " ") << quote(passes[i].name) << ": " << passes[i].averageMs;
+	}
+	out << " },\n";
+
+	if (!metrics.empty()) {
+		out << "  \"metrics\": {";
+		for (size_t i = 0; i < metrics.size(); i++)
+			out << (i ? ", " : " ") << quote(metrics[i].first) << ": " << metrics[i].second;
+		out << " },\n";
+	}
+
+	out << "  \"cpu_ms\": {\n";
+	const std::vector<ZoneStats>& zones = Profiler::Shared().Stats();
+	for (size_t i = 0; i < zones.size(); i++) {
+		out << "    " << quote(zones[i].name) << ": { \"min\": " << zones[i].minMs << ", \"avg\": " << zones[i].avgMs
+			<< ", \"p99\": " << zones[i].p99Ms << " }" << (i + 1 < zones.size() ? "," : "") << "\n";
+	}
+	out << "  },\n";
+
+	// Averages over every frame, including the first
+	const double counted = (double)(n + (started ? 1 : 0));
+	const double per = counted > 0.0 ? counted : 1.0;
+	out << "  \"per_frame\": {";
+	out << " \"draw_calls\": " << sum.total.drawCalls / per;
+	out << ", \"instances\": " << sum.total.instances / per;
+	out << ", \"triangles\": " << sum.total.triangles / per;
+	out << ", \"vertices\": " << sum.total.vertices / per;
+	out << ", \"state_changes\": " << sum.StateChanges() / per;
+	out << ", \"upload_bytes\": " << sum.uploadBytes / per;
+	out << ", \"elided_calls\": " << sum.elidedCalls / per << " }\n";
+	out << "}\n";
+}
+
+void PerfReport::ReserveStandardOutput()
+{
+	if (!standardOutput)
+		standardOutput = std::cout.rdbuf(std::cerr.rdbuf());
+}
+
+bool PerfReport::Write(const std::string& path) const
+{
+	if (path == "-") {
+		std::ostream out(standardOutput ? standardOutput : std::cout.rdbuf());
+		Write(out);
+		out.flush();
+		return true;
+	}
+	std::ofstream file(path.c_str(), std::ios::trunc);
+	if (!file) {
+		std::cout << "ERROR::PERF REPORT:: Could not write " << path << std::endl;
+		return false;
+	}
+	Write(file);
+	std::cout << "Perf Report: " << Frames() << " frames written to " << path << std::endl;
+	return true;
+}
@@ -0,0 +1,71 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Perf Report, frame times and counters of a benchmark run written as JSON
+
+// Std. Includes
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ostream>
+#include <utility>
+
+// custom Includes
+#include "FrameStats.h"
+
+class PerfReport
+{
+public:
+	// Constructor, the run's description goes at the top of the report
+	PerfReport(const std::string& backend, const std::string& renderer, int width, int height);
+
+	// Clock the frames were timed with
+	void SetClock(const std::string& mode, double step) { clockMode = mode; clockStep = step; }
+
+	// List every frame time in the report, for comparing runs frame for frame
+	void ListFrames(bool list) { listFrames = list; }
+
+	// Hash of the final frame's pixels, written when set
+	void SetFrameHash(const std::string& hash) { frameHash = hash; }
+
+	// GPU pass times come from the GpuProfiler, off for backends without a GL context
+	void TimeGpuPasses(bool timed) { gpuPasses = timed; }
+
+	// Extra figure a backend measures itself, e.g. triangles per second, written under "metrics"
+	void SetMetric(const std::string& name, double value) { metrics.push_back(std::make_pair(name, value)); }
+
+	// Once per presented frame, after the frame's stats have been closed
+	void Frame(const FrameCounters& counters);
+
+	// Frames recorded so far, and wall time since the first one
+	size_t Frames() const { return frameMs.size(); }
+	double Seconds() const;
+
+	// Everything as one JSON object: frame time percentiles, GPU passes, CPU zones, average draw counters
+	void Write(std::ostream& out) const;
+
+	// Write to a file, or standard output for "-"
+	bool Write(const std::string& path) const;
+
+	// Send everything else printed to std::cout to standard error, so a report written to "-" is the only thing on
+	// standard output. Call before anything is printed or any thread starts
+	static void ReserveStandardOutput();
+
+private:
+	/*  Report data  */
+	std::string backend;
+	std::string renderer;
+	int width, height;
+	std::string clockMode;
+	double clockStep;
+	std::chrono::steady_clock::time_point start, previous;
+	bool started;
+	std::vector<double> frameMs;
+	FrameCounters sum;
+	bool listFrames;
+	std::string frameHash;
+	bool gpuPasses;
+	std::vector<std::pair<std::string, double> > metrics;
+
+	static std::streambuf* standardOutput;   // Where std::cout went before ReserveStandardOutput
+};
@@ -0,0 +1,221 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Profiler, scoped CPU zones with rolling per-frame statistics and Chrome trace output
+
+// Std. Includes
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <iomanip>
+
+// custom Includes
+#include "Profiler.h"
+
+// Every zone is timed against the same origin so traces from all threads line up
+static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+
+Profiler::Profiler() :
+	history(HISTORY_EVENTS), historyThread(HISTORY_EVENTS), historyNext(0)
+{
+}
+
+Profiler& Profiler::Shared()
+{
+	static Profiler profiler;
+	return profiler;
+}
+
+uint64_t Profiler::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Profiler::Record(const char* name, uint64_t start, uint64_t end)
+{
+	push(*threadBuffer(), name, start, end);
+}
+
+int Profiler::AddTrack(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(registerLock);
+	return addBuffer(name, false)->id;
+}
+
+void Profiler::Record(int track, const char* name, uint64_t start, uint64_t end)
+{
+	ThreadBuffer* buffer;
+	{
+		std::lock_guard<std::mutex> lock(registerLock);
+		buffer = buffers[track].get();
+	}
+	push(*buffer, name, start, end);
+}
+
+void Profiler::NameThread(const std::string& name)
+{
+	ThreadBuffer* buffer = threadBuffer();
+	std::lock_guard<std::mutex> lock(registerLock);
+	buffer->name = name;
+}
+
+void Profiler::EndFrame()
+{
+	for (size_t i = 0; i < zones.size(); i++) {
+		zones[i].frameMs = 0.0;
+		zones[i].hit = false;
+	}
+
+	// Zones that finished on any thread since the last frame
+	{
+		std::lock_guard<std::mutex> lock(registerLock);
+		for (size_t i = 0; i < buffers.size(); i++)
+			drain(*buffers[i]);
+	}
+
+	// Roll each zone's frame total into its window, then take min / avg / p99 over the window
+	std::vector<double> sorted;
+	stats.resize(zones.size());
+	for (size_t i = 0; i < zones.size(); i++) {
+		Zone& z = zones[i];
+		if (z.hit) {
+			z.window[z.next] = z.frameMs;
+			z.next = (z.next + 1) % WINDOW;
+			z.count = std::min(z.count + 1, WINDOW);
+		}
+
+		ZoneStats& s = stats[i];
+		s.name = z.name;
+		s.frames = z.count;
+		if (z.count == 0) {
+			s.minMs = s.avgMs = s.p99Ms = 0.0;
+			continue;
+		}
+		sorted.assign(z.window, z.window + z.count);
+		std::sort(sorted.begin(), sorted.end());
+		double sum = 0.0;
+		for (size_t j = 0; j < sorted.size(); j++)
+			sum += sorted[j];
+		s.minMs = sorted.front();
+		s.avgMs = sum / sorted.size();
+		s.p99Ms = sorted[(sorted.size() * 99) / 100];
+	}
+
+	if (!tracePath.empty()) {
+		std::ofstream file(tracePath.c_str(), std::ios::trunc);
+		if (file) {
+			WriteTrace(file);
+			std::cout << "Profiler: Trace written to " << tracePath << std::endl;
+		}
+		else
+			std::cout << "ERROR::PROFILER:: Could not write trace " << tracePath << std::endl;
+		tracePath.clear();
+	}
+}
+
+void Profiler::RequestTrace(const std::string& path)
+{
+	tracePath = path;
+}
+
+void Profiler::WriteTrace(std::ostream& out) const
+{
+	// Complete ("X") events in microseconds, oldest first
+	out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[\n";
+	bool first = true;
+	for (size_t i = 0; i < HISTORY_EVENTS; i++) {
+		const size_t slot = (historyNext + i) % HISTORY_EVENTS;
+		const ProfileEvent& event = history[slot];
+		if (event.name == nullptr)
+			continue;
+		out << (first ? "" : ",\n") << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << historyThread[slot]
+			<< ",\"ts\":" << event.start / 1000.0 << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+		first = false;
+	}
+
+	// Label the threads
+	std::lock_guard<std::mutex> lock(registerLock);
+	for (size_t i = 0; i < buffers.size(); i++) {
+		out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i
+			<< ",\"args\":{\"name\":\"" << buffers[i]->name << "\"}}";
+		first = false;
+	}
+	out << "\n]}\n";
+}
+
+Profiler::ThreadBuffer* Profiler::threadBuffer()
+{
+	thread_local ThreadBuffer* buffer = nullptr;
+	if (buffer)
+		return buffer;
+
+	// First zone on this thread, give it a buffer of its own
+	std::lock_guard<std::mutex> lock(registerLock);
+	buffer = addBuffer("Thread " + std::to_string(buffers.size()), true);
+	return buffer;
+}
+
+// Caller holds registerLock
+Profiler::ThreadBuffer* Profiler::addBuffer(const std::string& name, bool statistics)
+{
+	buffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+	ThreadBuffer* buffer = buffers.back().get();
+	buffer->head = 0;
+	buffer->tail = 0;
+	buffer->id = (int)buffers.size() - 1;
+	buffer->name = name;
+	buffer->statistics = statistics;
+	return buffer;
+}
+
+void Profiler::push(ThreadBuffer& buffer, const char* name, uint64_t start, uint64_t end)
+{
+	// Full until the next EndFrame, lose the zone rather than wait
+	size_t head = buffer.head.load(std::memory_order_relaxed);
+	if (head - buffer.tail.load(std::memory_order_acquire) >= BUFFER_EVENTS)
+		return;
+
+	ProfileEvent& event = buffer.events[head % BUFFER_EVENTS];
+	event.name = name;
+	event.start = start;
+	event.end = end;
+	buffer.head.store(head + 1, std::memory_order_release);
+}
+
+Profiler::Zone& Profiler::zone(const char* name)
+{
+	std::map<const char*, int>::iterator it = zoneIndex.find(name);
+	if (it != zoneIndex.end())
+		return zones[it->second];
+
+	Zone z;
+	z.name = name;
+	z.frameMs = 0.0;
+	z.hit = false;
+	z.count = 0;
+	z.next = 0;
+	zoneIndex[name] = (int)zones.size();
+	zones.push_back(z);
+	return zones.back();
+}
+
+void Profiler::drain(ThreadBuffer& buffer)
+{
+	size_t tail = buffer.tail.load(std::memory_order_relaxed);
+	const size_t head = buffer.head.load(std::memory_order_acquire);
+	for (; tail != head; tail++) {
+		const ProfileEvent& event = buffer.events[tail % BUFFER_EVENTS];
+
+		if (buffer.statistics) {
+			Zone& z = zone(event.name);
+			z.frameMs += (event.end - event.start) / 1000000.0;
+			z.hit = true;
+		}
+
+		history[historyNext] = event;
+		historyThread[historyNext] = buffer.id;
+		historyNext = (historyNext + 1) % HISTORY_EVENTS;
+	}
+	buffer.tail.store(tail, std::memory_order_release);
+}
@@ -0,0 +1,126 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Profiler, scoped CPU zones with rolling per-frame statistics and Chrome trace output
+
+// Std. Includes
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <ostream>
+
+// One finished zone, times in nanoseconds since the profiler started
+struct ProfileEvent {
+	const char* name;  // Zone name, must be a string literal (compared by pointer)
+	uint64_t start;
+	uint64_t end;
+};
+
+// Rolling statistics of a zone's total time per frame, in milliseconds
+struct ZoneStats {
+	std::string name;
+	double minMs;
+	double avgMs;
+	double p99Ms;
+	int frames;        // Frames in the window the zone ran in
+};
+
+class Profiler
+{
+public:
+	// Nanoseconds since the profiler started, steady and monotonic
+	static uint64_t Now();
+
+	// Add a finished zone to the calling thread's buffer, never blocks after the thread's first zone
+	void Record(const char* name, uint64_t start, uint64_t end);
+
+	// Trace-only timeline for times measured elsewhere (e.g. the GPU), returns its id for Record
+	int AddTrack(const std::string& name);
+
+	// Add a zone to a track, only from the thread that owns the track's timings. Kept out of the statistics
+	void Record(int track, const char* name, uint64_t start, uint64_t end);
+
+	// Label the calling thread in traces
+	void NameThread(const std::string& name);
+
+	// Main thread, once per frame: collect every thread's zones, update statistics, write a requested trace
+	void EndFrame();
+
+	// Write the zones kept in the history as Chrome trace JSON at the end of the current frame
+	void RequestTrace(const std::string& path);
+
+	// Statistics of every zone seen, in first-seen order
+	const std::vector<ZoneStats>& Stats() const { return stats; }
+
+	// Chrome trace JSON (chrome://tracing, Perfetto) of the kept history
+	void WriteTrace(std::ostream& out) const;
+
+	// Single profiler shared by every thread
+	static Profiler& Shared();
+
+private:
+	Profiler();
+
+	static const size_t BUFFER_EVENTS = 1 << 14;   // Per thread, between two EndFrame calls
+	static const size_t HISTORY_EVENTS = 1 << 18;  // Kept for traces, roughly the last few thousand frames
+	static const int WINDOW = 240;                 // Frames the statistics roll over
+
+	// Single producer (its thread) / single consumer (EndFrame) ring of events
+	struct ThreadBuffer {
+		ProfileEvent events[BUFFER_EVENTS];
+		std::atomic<size_t> head;  // Advanced by the owning thread
+		std::atomic<size_t> tail;  // Advanced by EndFrame
+		int id;
+		std::string name;
+		bool statistics;           // False for tracks, their zones only go to traces
+	};
+
+	// Per-frame totals of one zone
+	struct Zone {
+		const char* name;
+		double frameMs;            // Accumulating this frame
+		bool hit;
+		double window[WINDOW];
+		int count;
+		int next;
+	};
+
+	ThreadBuffer* threadBuffer();
+	ThreadBuffer* addBuffer(const std::string& name, bool statistics);
+	static void push(ThreadBuffer& buffer, const char* name, uint64_t start, uint64_t end);
+	Zone& zone(const char* name);
+	void drain(ThreadBuffer& buffer);
+
+	/*  Profiler data  */
+	mutable std::mutex registerLock;     // Only taken the first time a thread records
+	std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+	std::map<const char*, int> zoneIndex;
+	std::vector<Zone> zones;
+	std::vector<ZoneStats> stats;
+	std::vector<ProfileEvent> history;
+	std::vector<int> historyThread;
+	size_t historyNext;
+	std::string tracePath;
+};
+
+// Times the enclosing scope
+class ProfileZone
+{
+public:
+	ProfileZone(const char* name) : name(name), start(Profiler::Now()) {}
+	~ProfileZone() { Profiler::Shared().Record(name, start, Profiler::Now()); }
+
+private:
+	const char* name;
+	uint64_t start;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+// PROFILE_ZONE("Name") times from here to the end of the scope
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
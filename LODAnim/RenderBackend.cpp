@@ -0,0 +1,34 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Render Backend, what the scene draws through, OpenGL or the software rasterizer
+
+// Std. Includes
+#include <algorithm>
+
+// custom Includes
+#include "RenderBackend.h"
+#include "NormalMatrix.h"
+
+
+void FillNormalMatrices(ObjectUniforms* objects, size_t count)
+{
+	// Only non-rigid transforms need the inverse-transpose, mat3(model) already works for rigid ones
+	if (count == 1 && IsRigidTransform(objects[0].model)) {
+		for (int i = 0; i < 3; i++)
+			objects[0].normalMatrix.columns[i] = objects[0].model[i];
+		return;
+	}
+
+	// Everything else vectorised, a batch at a time through the stack rather than two arrays per call
+	const size_t BATCH = 64;
+	glm::mat4 models[BATCH];
+	NormalMatrix normals[BATCH];
+	for (size_t first = 0; first < count; first += BATCH) {
+		const size_t n = std::min(BATCH, count - first);
+		for (size_t i = 0; i < n; i++)
+			models[i] = objects[first + i].model;
+		ComputeNormalMatrices(models, normals, n);
+		for (size_t i = 0; i < n; i++)
+			objects[first + i].normalMatrix = normals[i];
+	}
+}
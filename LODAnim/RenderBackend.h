@@ -0,0 +1,44 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Render Backend, what the scene draws through, OpenGL or the software rasterizer
+
+// Std. Includes
+#include <vector>
+#include <cstddef>
+
+// GL Includes
+#include <glm/glm.hpp>
+
+// custom Includes
+#include "Mesh.h"
+#include "UniformRing.h"
+
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend() {}
+
+	// Short name for reports and the command line
+	virtual const char* Name() const = 0;
+
+	// Start a frame: clear colour and depth, camera and light for every draw
+	virtual void BeginFrame(const FrameUniforms& frame, glm::vec4 clearColour) = 0;
+
+	// Time the draws between BeginPass and EndPass as one pass, pass must be a string literal
+	virtual void BeginPass(const char* pass) = 0;
+	virtual void EndPass() = 0;
+
+	// Draw count copies of a mesh, one per object, with the program of a set of ShaderVariant bits.
+	// VARIANT_INSTANCED draws batch the copies, without it each copy is its own draw. Normal matrices are filled in before the copies draw, for programs that read them
+	virtual void Draw(const Mesh& mesh, unsigned variant, ObjectUniforms* objects, size_t count, int level = -1) = 0;
+
+	// Everything for the frame has been drawn
+	virtual void EndFrame() = 0;
+
+	// RGBA8 pixels of the frame so far, bottom row first
+	virtual void ReadPixels(std::vector<unsigned char>& rgba) = 0;
+};
+
+// Inverse-transpose of each object's model matrix, rigid single draws just copy mat3(model)
+void FillNormalMatrices(ObjectUniforms* objects, size_t count);
@@ -0,0 +1,198 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Render Context, fullscreen window or headless offscreen target for the same scene
+
+// Std. Includes
+#include <iostream>
+#include <cstring>
+
+// custom Includes
+#include "RenderContext.h"
+
+#ifdef LODANIM_EGL
+#include <EGL/eglext.h>
+#endif
+
+
+RenderContext::RenderContext(const ContextOptions& options) :
+	window(NULL), width(options.width), height(options.height), headless(options.headless), FBO(0), colourRBO(0), depthRBO(0)
+{
+#ifdef LODANIM_EGL
+	display = EGL_NO_DISPLAY;
+	context = EGL_NO_CONTEXT;
+#endif
+
+	// Headless prefers EGL, which works without a display server; otherwise a hidden GLFW window
+	bool egl = false;
+#ifdef LODANIM_EGL
+	if (headless)
+		egl = createEGL();
+#endif
+	if (!egl)
+		createWindow(options);
+
+	// Set this to true so GLEW knows to use a modern approach to retrieving function pointers and extensions
+	glewExperimental = GL_TRUE;
+
+	// Initialize GLEW to setup the OpenGL Function pointers
+	GLenum status = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+	// A GLX build of GLEW still loads every GL entry point under EGL, only its GLX ones are missing
+	if (egl && status == GLEW_ERROR_NO_GLX_DISPLAY)
+		status = GLEW_OK;
+#endif
+	if (status != GLEW_OK)
+		throw "Error::RenderContext::GLEW Initialisation Failed\n";
+
+	if (headless)
+		createTarget();
+	glViewport(0, 0, width, height);
+}
+
+RenderContext::~RenderContext()
+{
+	if (FBO) {
+		glDeleteFramebuffers(1, &FBO);
+		glDeleteRenderbuffers(1, &colourRBO);
+		glDeleteRenderbuffers(1, &depthRBO);
+	}
+#ifdef LODANIM_EGL
+	if (context != EGL_NO_CONTEXT) {
+		eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		eglDestroyContext(display, context);
+		eglTerminate(display);
+	}
+#endif
+	if (window)
+		glfwTerminate();
+}
+
+void RenderContext::BeginFrame()
+{
+	if (FBO)
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+}
+
+void RenderContext::Present()
+{
+	// Nothing on screen, but the frame still has to be submitted for its queries and fences to complete
+	if (headless)
+		glFlush();
+	else
+		glfwSwapBuffers(window);
+}
+
+void RenderContext::PollEvents()
+{
+	if (window)
+		glfwPollEvents();
+}
+
+bool RenderContext::ShouldClose() const
+{
+	return window && glfwWindowShouldClose(window);
+}
+
+void RenderContext::createWindow(const ContextOptions& options)
+{
+	// Init GLFW
+	if (!glfwInit())
+		throw "Error::RenderContext::GLFW Initialisation Failed\n";
+
+	// Set all the required options for GLFW
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_RESIZABLE, GL_FALSE);
+	glfwWindowHint(GLFW_SAMPLES, 4);
+
+	// Create a GLFWwindow object that we can use for GLFW's functions, fullscreen unless it's only hosting the context
+	if (options.headless) {
+		glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+		window = glfwCreateWindow(1, 1, "LOD Animation", nullptr, nullptr);
+		glfwWindowHint(GLFW_VISIBLE, GL_TRUE);
+		backend = "GLFW hidden window";
+	}
+	else {
+		window = glfwCreateWindow(width, height, "LOD Animation", glfwGetPrimaryMonitor(), nullptr);
+		backend = "GLFW fullscreen window";
+	}
+	if (!window) {
+		glfwTerminate();
+		throw "Error::RenderContext::Window Creation Failed\n";
+	}
+	glfwMakeContextCurrent(window);
+	glfwSwapInterval(options.vsync ? 1 : 0);
+}
+
+bool RenderContext::createEGL()
+{
+#ifdef LODANIM_EGL
+	// Surfaceless platform first, no window system at all, then whatever the default display is
+	PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+	const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+	if (getPlatformDisplay && clientExtensions && std::strstr(clientExtensions, "EGL_MESA_platform_surfaceless"))
+		display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+	if (display == EGL_NO_DISPLAY)
+		display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+	EGLint major, minor;
+	if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+		std::cout << "ERROR::RENDER CONTEXT:: No EGL display, falling back to a hidden window" << std::endl;
+		display = EGL_NO_DISPLAY;
+		return false;
+	}
+
+	// Desktop GL rather than GLES, the shaders are #version 330 core
+	const EGLint configAttributes[] = {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_NONE
+	};
+	EGLConfig config = NULL;
+	EGLint configs = 0;
+	eglChooseConfig(display, configAttributes, &config, 1, &configs);
+	const EGLint contextAttributes[] = {
+		EGL_CONTEXT_MAJOR_VERSION, 3,
+		EGL_CONTEXT_MINOR_VERSION, 3,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE
+	};
+	if (eglBindAPI(EGL_OPENGL_API))
+		context = eglCreateContext(display, configs > 0 ? config : (EGLConfig)0, EGL_NO_CONTEXT, contextAttributes);
+
+	// Everything renders into our own framebuffer, so no surface is needed
+	if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+		std::cout << "ERROR::RENDER CONTEXT:: EGL context creation failed, falling back to a hidden window" << std::endl;
+		if (context != EGL_NO_CONTEXT)
+			eglDestroyContext(display, context);
+		context = EGL_NO_CONTEXT;
+		eglTerminate(display);
+		display = EGL_NO_DISPLAY;
+		return false;
+	}
+	backend = "EGL " + std::to_string(major) + "." + std::to_string(minor) + " surfaceless";
+	return true;
+#else
+	return false;
+#endif
+}
+
+void RenderContext::createTarget()
+{
+	// Colour and depth at the requested resolution, single sampled like the window
+	glGenRenderbuffers(1, &colourRBO);
+	glBindRenderbuffer(GL_RENDERBUFFER, colourRBO);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+	glGenRenderbuffers(1, &depthRBO);
+	glBindRenderbuffer(GL_RENDERBUFFER, depthRBO);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &FBO);
+	glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colourRBO);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthRBO);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		throw "Error::RenderContext::Offscreen Framebuffer Incomplete\n";
+}
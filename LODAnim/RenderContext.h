@@ -0,0 +1,73 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Render Context, fullscreen window or headless offscreen target for the same scene
+
+// Std. Includes
+#include <string>
+
+// GL Includes
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+// EGL surfaceless contexts (Mesa llvmpipe, GPU drivers) need no display server
+#ifdef __linux__
+#define LODANIM_EGL
+#include <EGL/egl.h>
+#endif
+
+// How to open the context, filled in from the command line
+struct ContextOptions {
+	bool headless;   // Render into an offscreen framebuffer, no visible window
+	int width;       // Resolution of the window or offscreen target
+	int height;
+	bool vsync;      // Off for benchmarks, frames are then only bounded by the machine
+};
+
+class RenderContext
+{
+public:
+	// Constructor, makes a GL 3.3 core context current and initialises GLEW, throws if none can be created
+	RenderContext(const ContextOptions& options);
+	~RenderContext();
+
+	// Window for input and shared contexts, NULL with EGL
+	GLFWwindow* Window() const { return window; }
+
+	// Resolution the scene renders at
+	int Width() const { return width; }
+	int Height() const { return height; }
+	bool Headless() const { return headless; }
+
+	// Which backend was picked, for reports
+	const std::string& Backend() const { return backend; }
+
+	// Bind the target the frame renders into
+	void BeginFrame();
+
+	// Show the frame, or just submit it when headless
+	void Present();
+
+	// Input events, nothing to poll when headless
+	void PollEvents();
+
+	// Window closed, headless runs are stopped by their frame budget instead
+	bool ShouldClose() const;
+
+private:
+	void createWindow(const ContextOptions& options);
+	bool createEGL();
+	void createTarget();
+
+	/*  Context data  */
+	GLFWwindow* window;
+	int width;
+	int height;
+	bool headless;
+	std::string backend;
+	GLuint FBO, colourRBO, depthRBO;   // Offscreen target, 0 when presenting to a window
+#ifdef LODANIM_EGL
+	EGLDisplay display;
+	EGLContext context;
+#endif
+};
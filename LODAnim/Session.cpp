@@ -0,0 +1,146 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Session, key presses and frame times recorded to a compact binary log and replayed from it
+
+// Std. Includes
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+
+// custom Includes
+#include "Session.h"
+
+static const char SESSION_MAGIC[4] = { 'L', 'O', 'D', 'S' };
+static const uint32_t SESSION_VERSION = 1;
+
+// Values are written in the host's byte order, little-endian on every platform we build for
+template <class T>
+static bool get(std::istream& in, T& value)
+{
+	return (bool)in.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+
+SessionRecorder::SessionRecorder() :
+	frames(0)
+{
+}
+
+bool SessionRecorder::Open(const std::string& path, const SessionHeader& header)
+{
+	file.open(path.c_str(), std::ios::binary | std::ios::trunc);
+	if (!file) {
+		std::cout << "ERROR::SESSION:: Could not write " << path << std::endl;
+		return false;
+	}
+	file.write(SESSION_MAGIC, sizeof(SESSION_MAGIC));
+	put(SESSION_VERSION);
+	put(header.width);
+	put(header.height);
+	put((uint32_t)header.timeline.size());
+	file.write(header.timeline.data(), header.timeline.size());
+	frames = 0;
+	return true;
+}
+
+void SessionRecorder::Key(int key, int action)
+{
+	if (!Recording() || key < 0)
+		return;
+	SessionInput input = { (uint16_t)key, (uint8_t)action };
+	pending.push_back(input);
+}
+
+void SessionRecorder::Frame(double time)
+{
+	if (!Recording())
+		return;
+
+	// More than 255 events between two frames can't come from a keyboard, the rest spill into the next frame
+	const size_t count = pending.size() < 255 ? pending.size() : 255;
+	put(time);
+	put((uint8_t)count);
+	for (size_t i = 0; i < count; i++) {
+		put(pending[i].key);
+		put(pending[i].action);
+	}
+	pending.erase(pending.begin(), pending.begin() + count);
+	frames++;
+}
+
+template <class T>
+void SessionRecorder::put(T value)
+{
+	file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+SessionReplay::SessionReplay() :
+	cursor(0)
+{
+}
+
+bool SessionReplay::Open(const std::string& path)
+{
+	std::ifstream file(path.c_str(), std::ios::binary);
+	if (!file) {
+		std::cout << "ERROR::SESSION:: Could not read " << path << std::endl;
+		return false;
+	}
+
+	char magic[4];
+	uint32_t version = 0, length = 0;
+	if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, SESSION_MAGIC, sizeof(magic)) != 0 || !get(file, version) || version != SESSION_VERSION) {
+		std::cout << "ERROR::SESSION:: " << path << " is not a version " << SESSION_VERSION << " session log" << std::endl;
+		return false;
+	}
+	if (!get(file, header.width) || !get(file, header.height) || !get(file, length) || length > 4096) {
+		std::cout << "ERROR::SESSION:: " << path << " has a damaged header" << std::endl;
+		return false;
+	}
+	header.timeline.resize(length);
+	if (length > 0 && !file.read(&header.timeline[0], length)) {
+		std::cout << "ERROR::SESSION:: " << path << " has a damaged header" << std::endl;
+		return false;
+	}
+
+	// Frames until the end of the file, a frame cut short by a crash is dropped
+	frames.clear();
+	SessionFrame frame;
+	uint8_t count;
+	while (get(file, frame.time) && get(file, count)) {
+		frame.inputs.resize(count);
+		bool complete = true;
+		for (uint8_t i = 0; i < count && complete; i++)
+			complete = get(file, frame.inputs[i].key) && get(file, frame.inputs[i].action);
+		if (!complete)
+			break;
+		frames.push_back(frame);
+	}
+	cursor = 0;
+	if (frames.empty()) {
+		std::cout << "ERROR::SESSION:: " << path << " has no frames" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool SessionReplay::Next(SessionFrame& frame)
+{
+	if (Finished())
+		return false;
+	frame = frames[cursor++];
+	return true;
+}
+
+std::string HashPixels(const std::vector<unsigned char>& pixels)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	for (size_t i = 0; i < pixels.size(); i++) {
+		hash ^= pixels[i];
+		hash *= 1099511628211ULL;
+	}
+	std::ostringstream hex;
+	hex << std::hex << std::setw(16) << std::setfill('0') << hash;
+	return hex.str();
+}
@@ -0,0 +1,86 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Session, key presses and frame times recorded to a compact binary log and replayed from it
+
+// Std. Includes
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+// Everything a replay needs to draw the same frames as the recording
+struct SessionHeader {
+	int32_t width;
+	int32_t height;
+	std::string timeline;
+};
+
+// One key event, as key_callback received it
+struct SessionInput {
+	uint16_t key;
+	uint8_t action;
+};
+
+// One recorded frame: its clock time, and the keys pressed or released just before it
+struct SessionFrame {
+	double time;
+	std::vector<SessionInput> inputs;
+};
+
+// Log layout, little-endian:
+//   "LODS", uint32 version, int32 width, int32 height, uint32 length, timeline path
+//   per frame: float64 time, uint8 input count, per input uint16 key, uint8 action
+class SessionRecorder
+{
+public:
+	SessionRecorder();
+
+	// Start a new log, false and an error if it can't be written
+	bool Open(const std::string& path, const SessionHeader& header);
+
+	// Key event during the frame being recorded
+	void Key(int key, int action);
+
+	// Close the frame with the time the clock gave it
+	void Frame(double time);
+
+	bool Recording() const { return file.is_open(); }
+	long long Frames() const { return frames; }
+
+private:
+	template <class T> void put(T value);
+
+	/*  Recorder data  */
+	std::ofstream file;
+	std::vector<SessionInput> pending;
+	long long frames;
+};
+
+class SessionReplay
+{
+public:
+	SessionReplay();
+
+	// Read a whole log, false and an error if it's missing or malformed
+	bool Open(const std::string& path);
+
+	const SessionHeader& Header() const { return header; }
+
+	// The next frame, false after the last one
+	bool Next(SessionFrame& frame);
+
+	// No frames left, the one returned last is the final frame
+	bool Finished() const { return cursor >= frames.size(); }
+
+	size_t Frames() const { return frames.size(); }
+
+private:
+	/*  Replay data  */
+	SessionHeader header;
+	std::vector<SessionFrame> frames;
+	size_t cursor;
+};
+
+// FNV-1a 64-bit hash of a frame's pixels, as 16 hex digits
+std::string HashPixels(const std::vector<unsigned char>& pixels);
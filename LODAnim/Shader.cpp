@@ -10,54 +10,67 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <chrono>
 
 // GL Includes
 #include <GL/glew.h>
 
 // custom Includes
 #include "Shader.h"
+#include "ShaderCache.h"
+#include "GLDispatch.h"
 
+// Insert preprocessor defines straight after the #version directive, which must stay first
+std::string Shader::InjectDefines(const std::string& code, const std::string& defines)
+{
+	if (defines.empty())
+		return code;
+	size_t version = code.find("#version");
+	if (version == std::string::npos)
+		return defines + code;
+	size_t lineEnd = code.find('\n', version);
+	if (lineEnd == std::string::npos)
+		return code + "\n" + defines;
+	return code.substr(0, lineEnd + 1) + defines + code.substr(lineEnd + 1);
+}
 
-Shader::Shader(const GLchar* vertexPath, const GLchar* fragmentPath) :
+Shader::Shader() :
+	Program(0)
+{
+}
+
+Shader::Shader(const GLchar* vertexPath, const GLchar* fragmentPath, const std::string& defines) :
 	Program(0)
 {
 	// Retrieve shaders source code from file path
 	std::string vertexCode;
 	std::string fragmentCode;
-	std::ifstream vShaderFile;
-	std::ifstream fShaderFile;
-
-	// Ensure ifstream objects can throw exceptions:
-	vShaderFile.exceptions(std::ifstream::badbit);
-	fShaderFile.exceptions(std::ifstream::badbit);
-
-	try {
-		// Open files
-		vShaderFile.open(vertexPath);
-		fShaderFile.open(fragmentPath);
-		std::stringstream vShaderStream, fShaderStream;
+	ReadSources(vertexPath, fragmentPath, defines, vertexCode, fragmentCode);
 
-		// Read file's buffer contents into streams
-		vShaderStream << vShaderFile.rdbuf();
-		fShaderStream << fShaderFile.rdbuf();
+	build(vertexCode, fragmentCode, "");
+}
 
-		// close file handlers
-		vShaderFile.close();
-		fShaderFile.close();
+Shader Shader::FromSource(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode)
+{
+	Shader shader;
+	shader.build(vertexCode, fragmentCode, geometryCode);
+	return shader;
+}
 
-		// Convert stream into GLchar array
-		vertexCode = vShaderStream.str();
-		fragmentCode = fShaderStream.str();
+void Shader::build(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode)
+{
+	// Reuse the linked binary from a previous launch if the sources and driver match
+	ShaderCache& cache = ShaderCache::Shared();
+	Program = cache.Load(vertexCode, fragmentCode, geometryCode);
+	if (Program)
+		return;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
-	}
-	catch(std::ifstream::failure e){
-		throw "Error::Shader::File Not Successfully Read\n";
-	}
 	const GLchar* vShaderCode = vertexCode.c_str();
 	const GLchar* fShaderCode = fragmentCode.c_str();
 
 	// Compile Shaders
-	GLuint vertex, fragment;
+	GLuint vertex, fragment, geometry = 0;
 	GLint success;
 	GLchar infoLog[512];
 
@@ -87,10 +100,30 @@ Shader::Shader(const GLchar* vertexPath, const GLchar* fragmentPath) :
 		throw "Error::Shader::Fragment Compilation Failed\n";
 	};
 
+	// Geometry Shader, only some programs have one
+	if (!geometryCode.empty()) {
+		const GLchar* gShaderCode = geometryCode.c_str();
+		geometry = glCreateShader(GL_GEOMETRY_SHADER);
+		glShaderSource(geometry, 1, &gShaderCode, NULL);
+		glCompileShader(geometry);
+
+		// Print compile errors
+		glGetShaderiv(geometry, GL_COMPILE_STATUS, &success);
+		if (!success) {
+			glGetShaderInfoLog(geometry, 512, NULL, infoLog);
+			std::cerr << infoLog << std::endl;
+			throw "Error::Shader::Geometry Compilation Failed\n";
+		};
+	}
+
 	// Shader Program
 	Program = glCreateProgram();
 	glAttachShader(Program, vertex);
 	glAttachShader(Program, fragment);
+	if (geometry)
+		glAttachShader(Program, geometry);
+	if (cache.Enabled())
+		glProgramParameteri(Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 	glLinkProgram(Program);
 
 	// Print linking errors
@@ -104,9 +137,55 @@ Shader::Shader(const GLchar* vertexPath, const GLchar* fragmentPath) :
 	// Delete the shaders
 	glDeleteShader(vertex);
 	glDeleteShader(fragment);
+	if (geometry)
+		glDeleteShader(geometry);
+
+	// Save for the next launch, along with how long this took
+	double compileMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	cache.Store(Program, vertexCode, fragmentCode, geometryCode, compileMs);
+}
+
+void Shader::ReadSources(const GLchar* vertexPath, const GLchar* fragmentPath, const std::string& defines, std::string& vertexCode, std::string& fragmentCode)
+{
+	std::ifstream vShaderFile;
+	std::ifstream fShaderFile;
+
+	// Ensure ifstream objects can throw exceptions:
+	vShaderFile.exceptions(std::ifstream::badbit);
+	fShaderFile.exceptions(std::ifstream::badbit);
+
+	try {
+		// Open files
+		vShaderFile.open(vertexPath);
+		fShaderFile.open(fragmentPath);
+		std::stringstream vShaderStream, fShaderStream;
+
+		// Read file's buffer contents into streams
+		vShaderStream << vShaderFile.rdbuf();
+		fShaderStream << fShaderFile.rdbuf();
+
+		// close file handlers
+		vShaderFile.close();
+		fShaderFile.close();
+
+		// Convert stream into GLchar array
+		vertexCode = InjectDefines(vShaderStream.str(), defines);
+		fragmentCode = InjectDefines(fShaderStream.str(), defines);
+
+	}
+	catch(std::ifstream::failure e){
+		throw "Error::Shader::File Not Successfully Read\n";
+	}
 }
 
 void Shader::Use()
 {
-	glUseProgram(Program);
+	GLDispatch::Shared().UseProgram(Program);
+}
+
+void Shader::BindBlock(const GLchar* blockName, GLuint binding)
+{
+	GLuint index = glGetUniformBlockIndex(Program, blockName);
+	if (index != GL_INVALID_INDEX)
+		glUniformBlockBinding(Program, index, binding);
 }
@@ -6,6 +6,9 @@
 // Source: https://learnopengl.com
 // Credit: JOEY DE VRIES
 
+// Std. Includes
+#include <string>
+
 // GL Includes
 #include <GL/glew.h>
 
@@ -14,8 +17,28 @@ class Shader
 public:
 	GLuint Program;
 
-	Shader(const GLchar * vertexPath, const GLchar * fragmentPath);
+	// Empty shader, Program is 0 until something links one (see ShaderManager)
+	Shader();
+
+	// defines are inserted after the #version line of both stages, e.g. "#define RIGID_TRANSFORM\n"
+	Shader(const GLchar * vertexPath, const GLchar * fragmentPath, const std::string& defines = "");
+
+	// Build a program from source already in memory, geometryCode may be empty
+	static Shader FromSource(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode = "");
 
 	void Use();
+
+	// Read both stages from disk with defines injected after #version
+	static void ReadSources(const GLchar* vertexPath, const GLchar* fragmentPath, const std::string& defines, std::string& vertexCode, std::string& fragmentCode);
+
+	// Insert defines straight after the #version directive, which must stay first
+	static std::string InjectDefines(const std::string& code, const std::string& defines);
+
+	// Attach a named uniform block to a binding point, ignored if the program doesn't declare it
+	void BindBlock(const GLchar* blockName, GLuint binding);
+
+private:
+	// Compile, link and cache, throws on errors
+	void build(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode);
 };
 
@@ -0,0 +1,195 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Shader Cache, linked program binaries stored on disk between launches
+
+// Std. Includes
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+// custom Includes
+#include "ShaderCache.h"
+
+// File layout: magic, source hash, driver string, binary format, compile time, binary
+static const uint32_t CACHE_MAGIC = 0x32444F4C; // "LOD2", "LODB" files had no source hash
+
+// Longer than any driver string, a length past it means the file is corrupt
+static const uint32_t MAX_DRIVER_LENGTH = 4096;
+
+// Enough to tell shader sources apart
+static uint64_t hashString(const std::string& text, uint64_t hash = 14695981039346656037ULL)
+{
+	return ShaderCache::Hash(text.data(), text.size(), hash);
+}
+
+static std::string glString(GLenum name)
+{
+	const GLubyte* value = glGetString(name);
+	return value ? (const char*)value : "";
+}
+
+
+ShaderCache::ShaderCache(const std::string& directory) :
+	directory(directory), enabled(false), hits(0), misses(0), savedMs(0.0)
+{
+	driver = glString(GL_VENDOR) + "|" + glString(GL_RENDERER) + "|" + glString(GL_VERSION);
+
+	// Need program binaries (GL 4.1) and at least one format the driver will hand back
+	GLint formats = 0;
+	if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	enabled = formats > 0;
+
+	if (enabled) {
+#ifdef _WIN32
+		_mkdir(directory.c_str());
+#else
+		mkdir(directory.c_str(), 0755);
+#endif
+	}
+}
+
+GLuint ShaderCache::Load(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode)
+{
+	if (!enabled)
+		return 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	std::ifstream file(pathFor(vertexCode, fragmentCode, geometryCode).c_str(), std::ios::binary | std::ios::ate);
+	if (!file) {
+		misses++;
+		return 0;
+	}
+	const std::streamoff fileSize = file.tellg();
+	file.seekg(0);
+
+	// Header, lengths are checked before anything is sized from them
+	uint32_t magic = 0, driverLength = 0, binaryLength = 0;
+	uint64_t fileHash = 0;
+	GLenum format = 0;
+	double compileMs = 0.0;
+	file.read((char*)&magic, sizeof(magic));
+	file.read((char*)&fileHash, sizeof(fileHash));
+	file.read((char*)&driverLength, sizeof(driverLength));
+	if (!file || magic != CACHE_MAGIC || fileHash != sourceHash(vertexCode, fragmentCode, geometryCode) || driverLength > MAX_DRIVER_LENGTH) {
+		misses++;
+		return 0;
+	}
+	std::string fileDriver(driverLength, '\0');
+	if (driverLength > 0)
+		file.read(&fileDriver[0], driverLength);
+	file.read((char*)&format, sizeof(format));
+	file.read((char*)&compileMs, sizeof(compileMs));
+	file.read((char*)&binaryLength, sizeof(binaryLength));
+
+	// Written by another driver or version, or cut short, recompile and overwrite it
+	if (!file || fileDriver != driver || binaryLength == 0 || binaryLength > fileSize - file.tellg()) {
+		misses++;
+		return 0;
+	}
+
+	std::vector<char> binary(binaryLength);
+	file.read(&binary[0], binaryLength);
+	if (!file) {
+		misses++;
+		return 0;
+	}
+
+	// The driver may still reject the binary, e.g. after an update that kept the version string
+	GLuint program = glCreateProgram();
+	glProgramBinary(program, format, &binary[0], binaryLength);
+	GLint success = 0;
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+	if (!success) {
+		glDeleteProgram(program);
+		misses++;
+		return 0;
+	}
+
+	double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	savedMs += compileMs - loadMs;
+	hits++;
+	return program;
+}
+
+void ShaderCache::Store(GLuint program, const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode, double compileMs)
+{
+	if (!enabled)
+		return;
+
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return;
+
+	std::vector<char> binary(length);
+	GLenum format = 0;
+	glGetProgramBinary(program, length, NULL, &format, &binary[0]);
+
+	std::ofstream file(pathFor(vertexCode, fragmentCode, geometryCode).c_str(), std::ios::binary | std::ios::trunc);
+	if (!file) {
+		std::cout << "ERROR::SHADER CACHE:: Could not write to " << directory << std::endl;
+		return;
+	}
+	uint32_t driverLength = (uint32_t)driver.size(), binaryLength = (uint32_t)length;
+	const uint64_t hash = sourceHash(vertexCode, fragmentCode, geometryCode);
+	file.write((const char*)&CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	file.write((const char*)&hash, sizeof(hash));
+	file.write((const char*)&driverLength, sizeof(driverLength));
+	file.write(driver.data(), driverLength);
+	file.write((const char*)&format, sizeof(format));
+	file.write((const char*)&compileMs, sizeof(compileMs));
+	file.write((const char*)&binaryLength, sizeof(binaryLength));
+	file.write(&binary[0], length);
+}
+
+void ShaderCache::Report(std::ostream& out) const
+{
+	if (!enabled) {
+		out << "SHADER CACHE: unavailable, driver exposes no program binary formats" << std::endl;
+		return;
+	}
+	out << "SHADER CACHE: " << hits << " hits, " << misses << " misses, "
+		<< std::fixed << std::setprecision(1) << savedMs << " ms saved" << std::endl;
+}
+
+ShaderCache& ShaderCache::Shared()
+{
+	static ShaderCache cache("../Shaders/cache/");
+	return cache;
+}
+
+uint64_t ShaderCache::Hash(const void* data, size_t bytes, uint64_t hash)
+{
+	const unsigned char* byte = (const unsigned char*)data;
+	for (size_t i = 0; i < bytes; i++) {
+		hash ^= byte[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+// Every stage, defines included. Each stage's length goes in too, so text can't move between stages unnoticed
+uint64_t ShaderCache::sourceHash(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode)
+{
+	std::ostringstream lengths;
+	lengths << vertexCode.size() << "|" << fragmentCode.size() << "|" << geometryCode.size();
+	return hashString(lengths.str(), hashString(geometryCode, hashString(fragmentCode, hashString(vertexCode))));
+}
+
+// Named by the source hash, the header holds it again to catch renamed or colliding files
+std::string ShaderCache::pathFor(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode) const
+{
+	std::ostringstream name;
+	name << directory << std::hex << std::setw(16) << std::setfill('0') << sourceHash(vertexCode, fragmentCode, geometryCode) << ".bin";
+	return name.str();
+}
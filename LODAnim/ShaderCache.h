@@ -0,0 +1,49 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Shader Cache, linked program binaries stored on disk between launches
+
+// Std. Includes
+#include <string>
+#include <ostream>
+#include <cstdint>
+
+// GL Includes
+#include <GL/glew.h>
+
+class ShaderCache
+{
+public:
+	// Constructor, binaries are kept in directory (created if missing)
+	ShaderCache(const std::string& directory);
+
+	// Link a program from a cached binary, 0 on a miss or if the driver rejects it
+	GLuint Load(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode = "");
+
+	// Save a freshly linked program, compileMs is what a later hit saves
+	void Store(GLuint program, const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode, double compileMs);
+
+	// Print hits, misses and time saved
+	void Report(std::ostream& out) const;
+
+	// Programs built before Store() should be linked with this hint
+	bool Enabled() const { return enabled; }
+
+	// 64-bit FNV-1a of bytes, continuing from hash. Other caches key their files with it too
+	static uint64_t Hash(const void* data, size_t bytes, uint64_t hash = 14695981039346656037ULL);
+
+	// Cache used by every Shader, created on first use (requires a current GL context)
+	static ShaderCache& Shared();
+
+private:
+	/*  Cache data  */
+	std::string directory;
+	std::string driver; // Vendor, renderer and version, a binary is only valid for the driver that made it
+	bool enabled;
+	int hits, misses;
+	double savedMs;
+
+	/*  Functions    */
+	static uint64_t sourceHash(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode);
+	std::string pathFor(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode) const;
+};
@@ -0,0 +1,314 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Shader Manager, compiles every program up front without blocking the first frame
+
+// Std. Includes
+#include <iostream>
+#include <iomanip>
+
+// custom Includes
+#include "ShaderManager.h"
+#include "ShaderCache.h"
+#include "Profiler.h"
+
+// Drivers can compile on their own threads (GL_KHR_parallel_shader_compile), program status
+// is then polled with GL_COMPLETION_STATUS_KHR. Otherwise the same work runs on a worker
+// thread with its own context sharing objects with the window's.
+
+ShaderManager::ShaderManager(GLFWwindow* window, const Shader& fallback) :
+	fallback(fallback), window(window), workerWindow(NULL), workerDone(0), workerExited(false), remaining(0), cached(0), firstPending(0), readyMs(0.0)
+{
+	mode = GLEW_KHR_parallel_shader_compile ? PARALLEL : SYNCHRONOUS;
+	if (mode == PARALLEL)
+		glMaxShaderCompilerThreadsKHR(0xFFFFFFFF); // Let the driver pick
+	start = std::chrono::steady_clock::now();
+}
+
+Shader& ShaderManager::Submit(const GLchar* vertexPath, const GLchar* fragmentPath, const std::string& defines, bool useFallback)
+{
+	std::string vertexCode, fragmentCode;
+	Shader::ReadSources(vertexPath, fragmentPath, defines, vertexCode, fragmentCode);
+	return SubmitSource(vertexCode, fragmentCode, "", useFallback);
+}
+
+Shader& ShaderManager::SubmitSource(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode, bool useFallback)
+{
+	shaders.push_back(useFallback ? fallback : Shader());
+	Job job;
+	job.shader = &shaders.back();
+	job.vertexCode = vertexCode;
+	job.fragmentCode = fragmentCode;
+	job.geometryCode = geometryCode;
+	job.vertex = job.fragment = job.geometry = job.program = 0;
+	job.linked = job.finished = false;
+	job.compileMs = 0.0;
+
+	// A cached binary is ready straight away
+	job.program = ShaderCache::Shared().Load(job.vertexCode, job.fragmentCode, job.geometryCode);
+	job.fromCache = job.program != 0;
+	if (job.fromCache) {
+		job.linked = true;
+		cached++;
+	}
+	{
+		std::lock_guard<std::mutex> lock(jobsLock);
+		jobs.push_back(job);
+	}
+	remaining++;
+	return shaders.back();
+}
+
+void ShaderManager::OnReady(Shader& shader, std::function<void(Shader&)> callback)
+{
+	for (size_t i = 0; i < jobs.size(); i++) {
+		if (jobs[i].shader == &shader) {
+			if (jobs[i].finished)
+				callback(shader);
+			else
+				jobs[i].callbacks.push_back(callback);
+			return;
+		}
+	}
+}
+
+void ShaderManager::BindBlock(const GLchar* blockName, GLuint binding)
+{
+	blocks.push_back(std::make_pair(std::string(blockName), binding));
+	fallback.BindBlock(blockName, binding);
+}
+
+void ShaderManager::Start()
+{
+	start = std::chrono::steady_clock::now();
+
+	if (mode == PARALLEL) {
+		// Every compile first, then every link, none of these calls wait on the driver
+		for (size_t i = 0; i < jobs.size(); i++)
+			if (!jobs[i].linked)
+				compile(jobs[i]);
+		for (size_t i = 0; i < jobs.size(); i++)
+			if (!jobs[i].linked)
+				link(jobs[i]);
+	}
+	else if (window) {
+		// Hidden 1x1 window whose context shares objects with the main one, must be created on this thread
+		glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+		workerWindow = glfwCreateWindow(1, 1, "", NULL, window);
+		glfwWindowHint(GLFW_VISIBLE, GL_TRUE);
+		glfwMakeContextCurrent(window);
+		if (workerWindow) {
+			mode = WORKER;
+			worker = std::thread(&ShaderManager::runWorker, this);
+		}
+	}
+
+	// Neither available, build everything now
+	if (mode == SYNCHRONOUS) {
+		for (size_t i = 0; i < jobs.size(); i++) {
+			if (!jobs[i].linked) {
+				compile(jobs[i]);
+				link(jobs[i]);
+				check(jobs[i]);
+			}
+		}
+	}
+	Update();
+}
+
+bool ShaderManager::Update()
+{
+	if (remaining == 0)
+		return true;
+
+	for (size_t i = firstPending; i < jobs.size(); i++) {
+		Job& job = jobs[i];
+		if (job.finished)
+			continue;
+
+		if (mode == WORKER) {
+			// The worker finishes jobs in order and glFinish()es before counting them. Jobs submitted after it
+			// ran out are built here. Exited is read first, the worker counts its last job before exiting
+			const bool exited = !workerRunning();
+			if ((int)i >= workerDone.load()) {
+				if (!exited)
+					break;
+				if (!job.linked) {
+					compile(job);
+					link(job);
+					check(job);
+				}
+			}
+		}
+		else if (!job.linked && job.vertex == 0) {
+			// Submitted after Start
+			compile(job);
+			link(job);
+			if (mode == PARALLEL)
+				continue;
+			check(job);
+		}
+		else if (mode == PARALLEL && !job.linked) {
+			// Polled once a frame, so the time is up to a frame late but never before the driver is done
+			GLint complete = GL_FALSE;
+			glGetProgramiv(job.program, GL_COMPLETION_STATUS_KHR, &complete);
+			if (!complete)
+				continue;
+			check(job);
+		}
+		finish(job);
+	}
+	while (firstPending < (int)jobs.size() && jobs[firstPending].finished)
+		firstPending++;
+
+	if (remaining == 0) {
+		readyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		if (worker.joinable())
+			worker.join();
+		if (workerWindow) {
+			glfwDestroyWindow(workerWindow);
+			workerWindow = NULL;
+		}
+		Report(std::cout);
+		ShaderCache::Shared().Report(std::cout);
+	}
+	return remaining == 0;
+}
+
+void ShaderManager::Report(std::ostream& out) const
+{
+	out << "SHADER MANAGER: " << jobs.size() << " programs (" << cached << " cached) built "
+		<< (mode == PARALLEL ? "by the driver in parallel" : mode == WORKER ? "on a worker context" : "synchronously")
+		<< ", all ready " << std::fixed << std::setprecision(1) << readyMs << " ms after start" << std::endl;
+}
+
+// Issue the compiles without asking for the status
+void ShaderManager::compile(Job& job)
+{
+	job.issued = std::chrono::steady_clock::now();
+	const GLchar* vShaderCode = job.vertexCode.c_str();
+	const GLchar* fShaderCode = job.fragmentCode.c_str();
+
+	job.vertex = glCreateShader(GL_VERTEX_SHADER);
+	glShaderSource(job.vertex, 1, &vShaderCode, NULL);
+	glCompileShader(job.vertex);
+
+	job.fragment = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(job.fragment, 1, &fShaderCode, NULL);
+	glCompileShader(job.fragment);
+
+	if (!job.geometryCode.empty()) {
+		const GLchar* gShaderCode = job.geometryCode.c_str();
+		job.geometry = glCreateShader(GL_GEOMETRY_SHADER);
+		glShaderSource(job.geometry, 1, &gShaderCode, NULL);
+		glCompileShader(job.geometry);
+	}
+}
+
+// Issue the link, the driver waits for the compiles internally
+void ShaderManager::link(Job& job)
+{
+	job.program = glCreateProgram();
+	glAttachShader(job.program, job.vertex);
+	glAttachShader(job.program, job.fragment);
+	if (job.geometry)
+		glAttachShader(job.program, job.geometry);
+	if (ShaderCache::Shared().Enabled())
+		glProgramParameteri(job.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(job.program);
+}
+
+// Read back status once complete and print the logs. The status queries wait for the driver, so the build is
+// timed up to here
+void ShaderManager::check(Job& job)
+{
+	GLint success;
+	GLchar infoLog[512];
+
+	glGetShaderiv(job.vertex, GL_COMPILE_STATUS, &success);
+	if (!success) {
+		glGetShaderInfoLog(job.vertex, 512, NULL, infoLog);
+		std::cerr << "Error::Shader::Vertex Compilation Failed\n" << infoLog << std::endl;
+	}
+	glGetShaderiv(job.fragment, GL_COMPILE_STATUS, &success);
+	if (!success) {
+		glGetShaderInfoLog(job.fragment, 512, NULL, infoLog);
+		std::cerr << "Error::Shader::Fragment Compilation Failed\n" << infoLog << std::endl;
+	}
+	if (job.geometry) {
+		glGetShaderiv(job.geometry, GL_COMPILE_STATUS, &success);
+		if (!success) {
+			glGetShaderInfoLog(job.geometry, 512, NULL, infoLog);
+			std::cerr << "Error::Shader::Geometry Compilation Failed\n" << infoLog << std::endl;
+		}
+	}
+	glGetProgramiv(job.program, GL_LINK_STATUS, &success);
+	if (!success) {
+		glGetProgramInfoLog(job.program, 512, NULL, infoLog);
+		std::cerr << "Error::Shader::Program::Linking Failed\n" << infoLog << std::endl;
+	}
+	job.linked = success != 0;
+	job.compileMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - job.issued).count();
+
+	// Delete the shaders
+	glDeleteShader(job.vertex);
+	glDeleteShader(job.fragment);
+	if (job.geometry)
+		glDeleteShader(job.geometry);
+	job.vertex = job.fragment = job.geometry = 0;
+}
+
+// Swap the real program in and cache its binary on the main thread, a failed one keeps drawing with its fallback
+void ShaderManager::finish(Job& job)
+{
+	job.finished = true;
+	remaining--;
+	if (!job.linked) {
+		glDeleteProgram(job.program);
+		return;
+	}
+	if (!job.fromCache)
+		ShaderCache::Shared().Store(job.program, job.vertexCode, job.fragmentCode, job.geometryCode, job.compileMs);
+
+	job.shader->Program = job.program;
+	for (size_t i = 0; i < blocks.size(); i++)
+		job.shader->BindBlock(blocks[i].first.c_str(), blocks[i].second);
+	for (size_t i = 0; i < job.callbacks.size(); i++)
+		job.callbacks[i](*job.shader);
+	job.callbacks.clear();
+}
+
+// Worker thread: build the jobs in order on the shared context
+void ShaderManager::runWorker()
+{
+	glfwMakeContextCurrent(workerWindow);
+	Profiler::Shared().NameThread("Shader Compiler");
+	for (size_t i = 0;; i++) {
+		Job* job;
+		{
+			std::lock_guard<std::mutex> lock(jobsLock);
+			if (i >= jobs.size()) {
+				workerExited = true;
+				break;
+			}
+			job = &jobs[i];
+		}
+
+		PROFILE_ZONE("Shader Compile");
+		if (!job->linked) {
+			compile(*job);
+			link(*job);
+			check(*job);
+		}
+		// Objects must be complete before another context uses them
+		glFinish();
+		workerDone.store((int)i + 1);
+	}
+	glfwMakeContextCurrent(NULL);
+}
+
+// False once the worker has taken its last job
+bool ShaderManager::workerRunning()
+{
+	std::lock_guard<std::mutex> lock(jobsLock);
+	return !workerExited;
+}
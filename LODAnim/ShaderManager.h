@@ -0,0 +1,92 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Shader Manager, compiles every program up front without blocking the first frame
+
+// Std. Includes
+#include <string>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <functional>
+#include <ostream>
+
+// GL Includes
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+// custom Includes
+#include "Shader.h"
+
+class ShaderManager
+{
+public:
+	// Constructor, window is shared with a hidden worker context when the driver can't compile in parallel.
+	// fallback is drawn with until a program is ready, so it should be cheap and already linked
+	ShaderManager(GLFWwindow* window, const Shader& fallback);
+
+	// Queue a program, the returned Shader draws with the fallback (or Program 0) until it is linked. Programs
+	// submitted after Start() are built from the next Update()
+	Shader& Submit(const GLchar* vertexPath, const GLchar* fragmentPath, const std::string& defines = "", bool useFallback = true);
+
+	// Same, from source already in memory, geometryCode may be empty
+	Shader& SubmitSource(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode, bool useFallback = true);
+
+	// Run callback once shader is linked, e.g. to set uniforms that never change
+	void OnReady(Shader& shader, std::function<void(Shader&)> callback);
+
+	// Uniform block bindings applied to every program as it becomes ready
+	void BindBlock(const GLchar* blockName, GLuint binding);
+
+	// Start compiling and linking everything submitted so far
+	void Start();
+
+	// Poll for finished programs once a frame, true once all of them are ready
+	bool Update();
+
+	// True once every submitted program is linked
+	bool Ready() const { return remaining == 0; }
+
+	// Print how the programs were built and how long until the last one was ready
+	void Report(std::ostream& out) const;
+
+private:
+	// One program being built
+	struct Job {
+		Shader* shader;
+		std::string vertexCode, fragmentCode, geometryCode;
+		GLuint vertex, fragment, geometry, program;
+		bool linked, finished;
+		bool fromCache;          // Loaded from a binary, nothing to store
+		std::chrono::steady_clock::time_point issued;
+		double compileMs;        // From issuing the compiles until the link status is known
+		std::vector<std::function<void(Shader&)> > callbacks;
+	};
+
+	/*  Manager data  */
+	std::deque<Shader> shaders; // Deque so references handed out stay valid
+	std::deque<Job> jobs;
+	std::mutex jobsLock;         // The worker indexes jobs while Submit may push more
+	std::vector<std::pair<std::string, GLuint> > blocks;
+	Shader fallback;
+	GLFWwindow* window;
+	GLFWwindow* workerWindow;
+	std::thread worker;
+	std::atomic<int> workerDone; // Jobs the worker has finished, in submission order
+	bool workerExited;           // Ran out of jobs, later ones are built on the main thread. Guarded by jobsLock
+	enum { PARALLEL, WORKER, SYNCHRONOUS } mode;
+	int remaining, cached, firstPending;
+	std::chrono::steady_clock::time_point start;
+	double readyMs;
+
+	/*  Functions    */
+	void compile(Job& job);
+	void link(Job& job);
+	void check(Job& job);
+	void finish(Job& job);
+	void runWorker();
+	bool workerRunning();
+};
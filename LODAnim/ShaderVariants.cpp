@@ -0,0 +1,87 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Shader Variants, every program built as a permutation of one uber shader
+
+// Std. Includes
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+// custom Includes
+#include "ShaderVariants.h"
+
+static const char* VARIANT_DEFINES[] = {
+	"LIT", "SPECULAR", "WIREFRAME", "INSTANCED", "PACKED_VERTEX", "RIGID_TRANSFORM", "NORMAL_MATRIX_PER_VERTEX", "TEXT", "IMPOSTOR", "IMPOSTOR_BAKE",
+	"OCTAHEDRAL_IMPOSTOR"
+};
+
+
+ShaderVariants::ShaderVariants(const GLchar* path)
+{
+	std::ifstream file(path);
+	if (!file)
+		throw "Error::Shader::File Not Successfully Read\n";
+	std::stringstream stream;
+	stream << file.rdbuf();
+	source = stream.str();
+}
+
+std::string ShaderVariants::Stage(GLenum stage, unsigned variant) const
+{
+	std::string defines = Defines(variant);
+	switch (stage) {
+	case GL_VERTEX_SHADER:
+		return Shader::InjectDefines(source, "#define VERTEX_STAGE\n" + defines);
+	case GL_GEOMETRY_SHADER:
+		if (!(variant & VARIANT_WIREFRAME))
+			return "";
+		return Shader::InjectDefines(source, "#define GEOMETRY_STAGE\n" + defines);
+	case GL_FRAGMENT_SHADER:
+		return Shader::InjectDefines(source, "#define FRAGMENT_STAGE\n" + defines);
+	default:
+		return "";
+	}
+}
+
+Shader ShaderVariants::Build(unsigned variant) const
+{
+	return Shader::FromSource(Stage(GL_VERTEX_SHADER, variant), Stage(GL_FRAGMENT_SHADER, variant), Stage(GL_GEOMETRY_SHADER, variant));
+}
+
+void ShaderVariants::Submit(ShaderManager& manager, unsigned variant, bool useFallback)
+{
+	if (programs.count(variant))
+		return;
+	programs[variant] = &manager.SubmitSource(Stage(GL_VERTEX_SHADER, variant), Stage(GL_FRAGMENT_SHADER, variant),
+		Stage(GL_GEOMETRY_SHADER, variant), useFallback);
+}
+
+Shader& ShaderVariants::Get(unsigned variant)
+{
+	std::map<unsigned, Shader*>::iterator it = programs.find(variant);
+	if (it != programs.end())
+		return *it->second;
+
+	// Drop optional features one at a time until a submitted variant matches
+	const unsigned optional[] = { VARIANT_SPECULAR, VARIANT_WIREFRAME, VARIANT_RIGID, VARIANT_PER_VERTEX_NORMALS };
+	unsigned reduced = variant;
+	for (int i = 0; i < 4; i++) {
+		reduced &= ~optional[i];
+		it = programs.find(reduced);
+		if (it != programs.end()) {
+			std::cout << "ERROR::SHADER VARIANTS:: Variant " << variant << " was not submitted, using " << reduced << std::endl;
+			programs[variant] = it->second;
+			return *it->second;
+		}
+	}
+	throw "Error::Shader::Variant Not Submitted\n";
+}
+
+std::string ShaderVariants::Defines(unsigned variant)
+{
+	std::string defines;
+	for (int bit = 0; bit < 11; bit++)
+		if (variant & (1u << bit))
+			defines += std::string("#define ") + VARIANT_DEFINES[bit] + "\n";
+	return defines;
+}
@@ -0,0 +1,68 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Shader Variants, every program built as a permutation of one uber shader
+
+// Std. Includes
+#include <string>
+#include <map>
+
+// GL Includes
+#include <GL/glew.h>
+
+// custom Includes
+#include "Shader.h"
+#include "ShaderManager.h"
+
+// Feature bits, each maps to a #define in uber.glsl. 0 is the unlit flat-colour program
+enum ShaderVariant {
+	VARIANT_LIT = 1 << 0,                      // Ambient + diffuse
+	VARIANT_SPECULAR = 1 << 1,                 // Phong highlight, needs VARIANT_LIT
+	VARIANT_WIREFRAME = 1 << 2,                // Edge overlay, adds the geometry stage
+	VARIANT_INSTANCED = 1 << 3,                // Per-object data indexed by gl_InstanceID
+	VARIANT_PACKED = 1 << 4,                   // 10:10:10:2 normals from a packed arena
+	VARIANT_RIGID = 1 << 5,                    // mat3(model) for normals
+	VARIANT_PER_VERTEX_NORMALS = 1 << 6,       // Full inverse per vertex, for timing comparisons
+	VARIANT_TEXT = 1 << 7,                     // HUD text
+	VARIANT_IMPOSTOR = 1 << 8,                 // Ray-cast sphere on a quad from ImpostorQuad
+	VARIANT_IMPOSTOR_BAKE = 1 << 9,            // Albedo, normal and depth targets of an ImpostorAtlas bake
+	VARIANT_OCTAHEDRAL = 1 << 10               // Baked ImpostorAtlas views on a quad from ImpostorQuad
+};
+
+// True if the variant's vertex stage reads ObjectUniforms::normalMatrix: lit, and its normals neither come from
+// mat3(model), a per-vertex inverse nor the impostor's own ray cast
+inline bool UsesNormalMatrix(unsigned variant)
+{
+	const unsigned ownNormals = VARIANT_RIGID | VARIANT_PER_VERTEX_NORMALS | VARIANT_IMPOSTOR | VARIANT_IMPOSTOR_BAKE | VARIANT_OCTAHEDRAL;
+	return (variant & VARIANT_LIT) && !(variant & ownNormals);
+}
+
+// Objects drawn with VARIANT_INSTANCED per glDrawElementsInstanced call, matches MAX_INSTANCES
+const int MAX_INSTANCES = 128;
+
+class ShaderVariants
+{
+public:
+	// Constructor, reads the uber shader source
+	ShaderVariants(const GLchar* path);
+
+	// Source of one stage of a variant, empty if the variant doesn't use the stage
+	std::string Stage(GLenum stage, unsigned variant) const;
+
+	// Compile a variant right now, used for the fallback program
+	Shader Build(unsigned variant) const;
+
+	// Queue a variant with the manager, before the manager is started
+	void Submit(ShaderManager& manager, unsigned variant, bool useFallback = true);
+
+	// Program for a variant, a variant that was never submitted falls back to the closest one that was
+	Shader& Get(unsigned variant);
+
+	// #define lines for a set of feature bits
+	static std::string Defines(unsigned variant);
+
+private:
+	/*  Variant data  */
+	std::string source;
+	std::map<unsigned, Shader*> programs;
+};
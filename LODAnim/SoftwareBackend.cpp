@@ -0,0 +1,89 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Software Backend, draws the scene on the CPU with the tiled rasterizer, no GL context needed
+
+// Std. Includes
+#include <cmath>
+
+// custom Includes
+#include "SoftwareBackend.h"
+#include "ShaderVariants.h"
+#include "FrameStats.h"
+#include "Profiler.h"
+
+
+SoftwareBackend::SoftwareBackend(int width, int height, unsigned threads) :
+	pool(threads, "Raster"), rasterizer(width, height, pool), pass(nullptr), passStart(0)
+{
+}
+
+void SoftwareBackend::BeginFrame(const FrameUniforms& frame, glm::vec4 clearColour)
+{
+	rasterizer.BeginFrame(frame, clearColour);
+}
+
+void SoftwareBackend::BeginPass(const char* name)
+{
+	pass = name;
+	passStart = Profiler::Now();
+}
+
+void SoftwareBackend::EndPass()
+{
+	rasterizer.Flush();
+	if (pass)
+		Profiler::Shared().Record(pass, passStart, Profiler::Now());
+	pass = nullptr;
+}
+
+void SoftwareBackend::Draw(const Mesh& mesh, unsigned variant, ObjectUniforms* objects, size_t count, int level)
+{
+	PROFILE_ZONE("Draw Submission");
+	const bool lit = (variant & VARIANT_LIT) != 0, specular = (variant & VARIANT_SPECULAR) != 0;
+	if (variant & VARIANT_IMPOSTOR) {
+		// The quad's half width is the sphere's radius
+		if (count > 0)
+			rasterizer.DrawSpheres(objects, count, std::abs(mesh.vertices[0].Position.x), lit, specular);
+	}
+	else {
+		FillNormalMatrices(objects, count);
+		rasterizer.Draw(mesh.vertices, mesh.indices, objects, count, lit, specular);
+	}
+
+	// Counted like the GL path, so reports of both backends line up
+	const GLsizei indexCount = (GLsizei)mesh.indices.size(), vertexCount = (GLsizei)mesh.vertices.size();
+	if (variant & VARIANT_INSTANCED)
+		FrameStats::Shared().Draw(indexCount, vertexCount, (GLsizei)count, level);
+	else {
+		for (size_t i = 0; i < count; i++)
+			FrameStats::Shared().Draw(indexCount, vertexCount, 1, level);
+	}
+}
+
+void SoftwareBackend::EndFrame()
+{
+	rasterizer.Flush();
+}
+
+void SoftwareBackend::ReadPixels(std::vector<unsigned char>& rgba)
+{
+	rasterizer.ReadPixels(rgba);
+}
+
+double SoftwareBackend::TrianglesPerSecond() const
+{
+	const RasterStats& stats = rasterizer.Stats();
+	const double seconds = stats.setupSeconds + stats.rasterSeconds;
+	return seconds > 0.0 ? stats.trianglesSubmitted / seconds : 0.0;
+}
+
+double SoftwareBackend::PixelsPerSecond() const
+{
+	const RasterStats& stats = rasterizer.Stats();
+	return stats.rasterSeconds > 0.0 ? stats.pixelsShaded / stats.rasterSeconds : 0.0;
+}
+
+std::string SoftwareBackend::Description() const
+{
+	return "SSE2 64x64 tiles, " + std::to_string(pool.Workers() + 1) + " threads";
+}
@@ -0,0 +1,52 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Software Backend, draws the scene on the CPU with the tiled rasterizer, no GL context needed
+
+// Std. Includes
+#include <string>
+#include <vector>
+
+// custom Includes
+#include "RenderBackend.h"
+#include "SoftwareRasterizer.h"
+#include "ThreadPool.h"
+
+class SoftwareBackend : public RenderBackend
+{
+public:
+	// Constructor, 0 threads means one per hardware thread
+	SoftwareBackend(int width, int height, unsigned threads = 0);
+
+	const char* Name() const { return "software"; }
+
+	void BeginFrame(const FrameUniforms& frame, glm::vec4 clearColour);
+
+	// Passes are CPU zones, the queued triangles are rasterized at EndPass so the pass owns its tile work
+	void BeginPass(const char* pass);
+	void EndPass();
+
+	// Lit and specular variants are shaded with Phong, the others flat. Wireframe draws the solid mesh.
+	// Impostors are ray-cast per pixel as exact spheres of the quad's radius, like the GL path
+	void Draw(const Mesh& mesh, unsigned variant, ObjectUniforms* objects, size_t count, int level = -1);
+
+	void EndFrame();
+
+	void ReadPixels(std::vector<unsigned char>& rgba);
+
+	// Throughput since the backend was created, over the time spent in setup and tiles
+	double TrianglesPerSecond() const;
+	double PixelsPerSecond() const;
+
+	// Instruction set and worker count, for reports
+	std::string Description() const;
+
+	const RasterStats& Stats() const { return rasterizer.Stats(); }
+
+private:
+	/*  Backend data  */
+	ThreadPool pool;
+	SoftwareRasterizer rasterizer;
+	const char* pass;
+	uint64_t passStart;
+};
@@ -0,0 +1,506 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Software Rasterizer, tile-based multithreaded triangle rasterizer for hosts without a GPU
+
+// Std. Includes
+#include <cmath>
+#include <algorithm>
+#include <emmintrin.h>
+
+// custom Includes
+#include "SoftwareRasterizer.h"
+#include "Profiler.h"
+
+// Pixels per tile side, one tile is one job
+static const int TILE = 64;
+
+// Pixels per hierarchical depth block side
+static const int BLOCK = 8;
+
+// Triangles queued before Draw flushes on its own, about 40 MB of set up triangles
+static const size_t MAX_QUEUED = 1 << 18;
+
+// Marks a bin entry as an index into the spheres rather than the triangles
+static const uint32_t SPHERE_BIT = 0x80000000u;
+
+// Phong constants of the uber shader
+static const float AMBIENT_STRENGTH = 0.2f, SPECULAR_STRENGTH = 0.8f, SHININESS = 32.0f;
+
+static uint32_t packColour(glm::vec3 colour)
+{
+	uint32_t r = (uint32_t)(std::min(std::max(colour.x, 0.0f), 1.0f) * 255.0f + 0.5f);
+	uint32_t g = (uint32_t)(std::min(std::max(colour.y, 0.0f), 1.0f) * 255.0f + 0.5f);
+	uint32_t b = (uint32_t)(std::min(std::max(colour.z, 0.0f), 1.0f) * 255.0f + 0.5f);
+	return r | (g << 8) | (b << 16) | (255u << 24);
+}
+
+
+SoftwareRasterizer::SoftwareRasterizer(int width, int height, ThreadPool& pool) :
+	width(width), height(height), clearValue(0), pool(pool)
+{
+	stride = (width + BLOCK - 1) / BLOCK * BLOCK;
+	rows = (height + BLOCK - 1) / BLOCK * BLOCK;
+	tilesX = (stride + TILE - 1) / TILE;
+	tilesY = (rows + TILE - 1) / TILE;
+
+	colour.assign((size_t)stride * rows, 0);
+	depth.assign((size_t)stride * rows, 1.0f);
+	blockDepth.assign((size_t)(stride / BLOCK) * (rows / BLOCK), 1.0f);
+	bins.resize((size_t)tilesX * tilesY);
+	cleared.assign(bins.size(), 0);
+	tilePixels.assign(bins.size(), 0);
+	ResetStats();
+}
+
+void SoftwareRasterizer::BeginFrame(const FrameUniforms& frame, glm::vec4 clearColour)
+{
+	viewProjection = frame.projection * frame.view;
+	lightPos = glm::vec3(frame.lightPos);
+	lightColour = glm::vec3(frame.lightColour);
+	viewPos = glm::vec3(frame.viewPos);
+	clearValue = packColour(glm::vec3(clearColour));
+
+	// Rays through pixel centres, from the perspective projection's scale and offset. The view is rigid, its
+	// inverse is the transposed rotation
+	const glm::mat4& projection = frame.projection;
+	const glm::mat3 viewToWorld = glm::transpose(glm::mat3(frame.view));
+	eye = -(viewToWorld * glm::vec3(frame.view[3]));
+	rayStepX = viewToWorld * glm::vec3(2.0f / (width * projection[0][0]), 0.0f, 0.0f);
+	rayStepY = viewToWorld * glm::vec3(0.0f, 2.0f / (height * projection[1][1]), 0.0f);
+	rayCorner = viewToWorld * glm::vec3((1.0f / width - 1.0f + projection[2][0]) / projection[0][0],
+		(1.0f / height - 1.0f + projection[2][1]) / projection[1][1], -1.0f);
+
+	// Tiles clear themselves when they're first rasterized
+	for (size_t i = 0; i < bins.size(); i++)
+		bins[i].clear();
+	triangles.clear();
+	spheres.clear();
+	std::fill(cleared.begin(), cleared.end(), 0);
+}
+
+void SoftwareRasterizer::Draw(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices, const ObjectUniforms* objects, size_t count, bool lit, bool specular)
+{
+	const size_t vertexCount = vertices.size(), triangleCount = indices.size() / 3;
+	if (count == 0 || triangleCount == 0)
+		return;
+	stats.trianglesSubmitted += triangleCount * count;
+
+	// Objects in groups small enough for the queue, everything queued so far is flushed to make room
+	const size_t group = std::max((size_t)1, MAX_QUEUED / triangleCount);
+	for (size_t first = 0; first < count; first += group) {
+		const size_t n = std::min(group, count - first);
+		if (!triangles.empty() && triangles.size() + n * triangleCount > MAX_QUEUED)
+			Flush();
+
+		PROFILE_ZONE("Raster Setup");
+		const uint64_t start = Profiler::Now();
+
+		// Vertex stage, spread over the pool a few objects at a time
+		clipVertices.resize(n * vertexCount);
+		const size_t perJob = std::max((size_t)1, 4096 / vertexCount);
+		pool.ParallelFor((n + perJob - 1) / perJob, [&](size_t job) {
+			const size_t end = std::min(n, (job + 1) * perJob);
+			for (size_t o = job * perJob; o < end; o++) {
+				const ObjectUniforms& object = objects[first + o];
+				const glm::mat4 mvp = viewProjection * object.model;
+				const glm::mat3 normalMatrix(glm::vec3(object.normalMatrix.columns[0]), glm::vec3(object.normalMatrix.columns[1]), glm::vec3(object.normalMatrix.columns[2]));
+				ClipVertex* out = &clipVertices[o * vertexCount];
+				for (size_t v = 0; v < vertexCount; v++) {
+					const glm::vec4 position(vertices[v].Position, 1.0f);
+					out[v].clip = mvp * position;
+					out[v].world = glm::vec3(object.model * position);
+					out[v].normal = normalMatrix * vertices[v].Normal;
+				}
+			}
+		});
+
+		// Clip against the near plane (z >= -w), then cull, set up and bin what's left
+		for (size_t o = 0; o < n; o++) {
+			const ClipVertex* corners = &clipVertices[o * vertexCount];
+			const glm::vec3 objectColour(objects[first + o].colour);
+			for (size_t t = 0; t < triangleCount; t++) {
+				const ClipVertex* v[3] = { &corners[indices[t * 3]], &corners[indices[t * 3 + 1]], &corners[indices[t * 3 + 2]] };
+				float d[3];
+				int inside = 0;
+				for (int i = 0; i < 3; i++) {
+					d[i] = v[i]->clip.z + v[i]->clip.w;
+					inside += d[i] >= 0.0f;
+				}
+				if (inside == 3) {
+					setupTriangle(*v[0], *v[1], *v[2], objectColour, lit, specular);
+					continue;
+				}
+				if (inside == 0)
+					continue;
+
+				// One or two corners behind the near plane leave a triangle or a quad, kept in winding order
+				ClipVertex polygon[4];
+				int sides = 0;
+				for (int i = 0; i < 3; i++) {
+					const int j = (i + 1) % 3;
+					if (d[i] >= 0.0f)
+						polygon[sides++] = *v[i];
+					if ((d[i] >= 0.0f) != (d[j] >= 0.0f)) {
+						const float s = d[i] / (d[i] - d[j]);
+						polygon[sides].clip = v[i]->clip + (v[j]->clip - v[i]->clip) * s;
+						polygon[sides].world = v[i]->world + (v[j]->world - v[i]->world) * s;
+						polygon[sides].normal = v[i]->normal + (v[j]->normal - v[i]->normal) * s;
+						sides++;
+					}
+				}
+				setupTriangle(polygon[0], polygon[1], polygon[2], objectColour, lit, specular);
+				if (sides == 4)
+					setupTriangle(polygon[0], polygon[2], polygon[3], objectColour, lit, specular);
+			}
+		}
+		stats.setupSeconds += (Profiler::Now() - start) * 1e-9;
+	}
+}
+
+void SoftwareRasterizer::setupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, const glm::vec3& objectColour, bool lit, bool specular)
+{
+	// Perspective divide into pixels, y up like the GL viewport, depth 0 to 1 like glDepthRange
+	const ClipVertex* v[3] = { &v0, &v1, &v2 };
+	float x[3], y[3], z[3], iw[3];
+	for (int i = 0; i < 3; i++) {
+		iw[i] = 1.0f / v[i]->clip.w;
+		x[i] = (v[i]->clip.x * iw[i] * 0.5f + 0.5f) * width;
+		y[i] = (v[i]->clip.y * iw[i] * 0.5f + 0.5f) * height;
+		z[i] = v[i]->clip.z * iw[i] * 0.5f + 0.5f;
+	}
+
+	// Counter-clockwise is front facing and back faces are culled, as with GL_CULL_FACE
+	const float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (!(area > 0.0f))
+		return;
+
+	// Pixels whose centres can fall inside, clamped to the screen
+	Triangle triangle;
+	triangle.minX = std::max(0, (int)std::ceil(std::min(std::min(x[0], x[1]), x[2]) - 0.5f));
+	triangle.maxX = std::min(width - 1, (int)std::floor(std::max(std::max(x[0], x[1]), x[2]) - 0.5f));
+	triangle.minY = std::max(0, (int)std::ceil(std::min(std::min(y[0], y[1]), y[2]) - 0.5f));
+	triangle.maxY = std::min(height - 1, (int)std::floor(std::max(std::max(y[0], y[1]), y[2]) - 0.5f));
+	triangle.minDepth = std::min(std::min(z[0], z[1]), z[2]);
+	if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY || triangle.minDepth > 1.0f)
+		return;
+
+	// Edge i runs between the other two corners and is 1 at corner i
+	const float inverseArea = 1.0f / area;
+	triangle.depthA = triangle.depthB = triangle.depthC = 0.0f;
+	for (int i = 0; i < 3; i++) {
+		const int j = (i + 1) % 3, k = (i + 2) % 3;
+		triangle.edgeA[i] = (y[j] - y[k]) * inverseArea;
+		triangle.edgeB[i] = (x[k] - x[j]) * inverseArea;
+		triangle.edgeC[i] = (x[j] * y[k] - x[k] * y[j]) * inverseArea;
+
+		// Left edges (inside to the right) and top edges (inside below) own the pixels they pass through
+		const bool topLeft = triangle.edgeA[i] > 0.0f || (triangle.edgeA[i] == 0.0f && triangle.edgeB[i] < 0.0f);
+		triangle.topLeft[i] = topLeft ? 0xFFFFFFFFu : 0u;
+
+		triangle.depthA += triangle.edgeA[i] * z[i];
+		triangle.depthB += triangle.edgeB[i] * z[i];
+		triangle.depthC += triangle.edgeC[i] * z[i];
+		triangle.invW[i] = iw[i];
+		triangle.world[i] = v[i]->world * iw[i];
+		triangle.normal[i] = v[i]->normal * iw[i];
+	}
+	triangle.colour = objectColour;
+	triangle.lit = lit;
+	triangle.specular = specular;
+
+	const uint32_t index = (uint32_t)triangles.size();
+	triangles.push_back(triangle);
+	for (int ty = triangle.minY / TILE; ty <= triangle.maxY / TILE; ty++)
+		for (int tx = triangle.minX / TILE; tx <= triangle.maxX / TILE; tx++)
+			bins[ty * tilesX + tx].push_back(index);
+	stats.trianglesRasterized++;
+}
+
+void SoftwareRasterizer::DrawSpheres(const ObjectUniforms* objects, size_t count, float radius, bool lit, bool specular)
+{
+	PROFILE_ZONE("Raster Setup");
+	const uint64_t start = Profiler::Now();
+
+	// Clip w runs along the view direction, the sphere's nearest depth is its radius back along it
+	const glm::vec3 forward = glm::normalize(glm::vec3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3]));
+	for (size_t o = 0; o < count; o++) {
+		if (spheres.size() >= MAX_QUEUED)
+			Flush();
+
+		const glm::mat4& model = objects[o].model;
+		Sphere sphere;
+		sphere.centre = glm::vec3(model[3]);
+		sphere.radius = radius * glm::length(glm::vec3(model[0]));
+		sphere.toCentre = sphere.centre - eye;
+		sphere.distance2 = glm::dot(sphere.toCentre, sphere.toCentre);
+
+		// Spheres the eye is in or the near plane cuts are left out, they're never far enough to be impostors
+		const float radius2 = sphere.radius * sphere.radius;
+		if (sphere.distance2 <= radius2 * 1.01f)
+			continue;
+		const glm::vec4 nearest = viewProjection * glm::vec4(sphere.centre - forward * sphere.radius, 1.0f);
+		if (nearest.z < -nearest.w)
+			continue;
+		sphere.minDepth = nearest.z / nearest.w * 0.5f + 0.5f;
+		if (sphere.minDepth > 1.0f)
+			continue;
+
+		// Pixels the silhouette can cover, from the square facing the eye the IMPOSTOR variant draws
+		const float halfSize = sphere.radius * std::sqrt(sphere.distance2 / (sphere.distance2 - radius2));
+		const glm::vec3 back = -sphere.toCentre / std::sqrt(sphere.distance2);
+		const glm::vec3 worldUp = std::abs(back.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+		const glm::vec3 right = glm::normalize(glm::cross(worldUp, back)) * halfSize;
+		const glm::vec3 up = glm::cross(back, right);
+		float minX = (float)width, minY = (float)height, maxX = 0.0f, maxY = 0.0f;
+		bool behind = false;
+		for (int corner = 0; corner < 4; corner++) {
+			const glm::vec3 position = sphere.centre + (corner & 1 ? right : -right) + (corner & 2 ? up : -up);
+			const glm::vec4 clip = viewProjection * glm::vec4(position, 1.0f);
+			behind = behind || clip.w <= 0.0f;
+			const float x = (clip.x / clip.w * 0.5f + 0.5f) * width, y = (clip.y / clip.w * 0.5f + 0.5f) * height;
+			minX = std::min(minX, x);
+			minY = std::min(minY, y);
+			maxX = std::max(maxX, x);
+			maxY = std::max(maxY, y);
+		}
+		if (behind)
+			continue;
+		sphere.minX = std::max(0, (int)std::ceil(minX - 0.5f));
+		sphere.maxX = std::min(width - 1, (int)std::floor(maxX - 0.5f));
+		sphere.minY = std::max(0, (int)std::ceil(minY - 0.5f));
+		sphere.maxY = std::min(height - 1, (int)std::floor(maxY - 0.5f));
+		if (sphere.minX > sphere.maxX || sphere.minY > sphere.maxY)
+			continue;
+		sphere.colour = glm::vec3(objects[o].colour);
+		sphere.lit = lit;
+		sphere.specular = specular;
+
+		const uint32_t index = (uint32_t)spheres.size() | SPHERE_BIT;
+		spheres.push_back(sphere);
+		for (int ty = sphere.minY / TILE; ty <= sphere.maxY / TILE; ty++)
+			for (int tx = sphere.minX / TILE; tx <= sphere.maxX / TILE; tx++)
+				bins[ty * tilesX + tx].push_back(index);
+	}
+	stats.setupSeconds += (Profiler::Now() - start) * 1e-9;
+}
+
+void SoftwareRasterizer::Flush()
+{
+	PROFILE_ZONE("Raster Tiles");
+	const uint64_t start = Profiler::Now();
+
+	// Every tile, so ones nothing was drawn in are still cleared
+	pool.ParallelFor(bins.size(), [this](size_t tile) { rasterTile(tile); });
+
+	for (size_t i = 0; i < bins.size(); i++) {
+		bins[i].clear();
+		stats.pixelsShaded += tilePixels[i];
+		tilePixels[i] = 0;
+	}
+	triangles.clear();
+	spheres.clear();
+	stats.rasterSeconds += (Profiler::Now() - start) * 1e-9;
+}
+
+void SoftwareRasterizer::rasterTile(size_t tile)
+{
+	const int x0 = (int)(tile % tilesX) * TILE, y0 = (int)(tile / tilesX) * TILE;
+	const int x1 = std::min(x0 + TILE, stride), y1 = std::min(y0 + TILE, rows);
+	const int blocksPerRow = stride / BLOCK;
+
+	if (!cleared[tile]) {
+		for (int y = y0; y < y1; y++) {
+			std::fill(&colour[(size_t)y * stride + x0], &colour[(size_t)y * stride + x1], clearValue);
+			std::fill(&depth[(size_t)y * stride + x0], &depth[(size_t)y * stride + x1], 1.0f);
+		}
+		for (int by = y0 / BLOCK; by < y1 / BLOCK; by++)
+			std::fill(&blockDepth[(size_t)by * blocksPerRow + x0 / BLOCK], &blockDepth[(size_t)by * blocksPerRow + x1 / BLOCK], 1.0f);
+		cleared[tile] = 1;
+	}
+
+	const __m128 lanes = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+	const __m128 zero = _mm_setzero_ps();
+	uint64_t pixels = 0;
+
+	const std::vector<uint32_t>& bin = bins[tile];
+	for (size_t b = 0; b < bin.size(); b++) {
+		if (bin[b] & SPHERE_BIT) {
+			rasterSphere(spheres[bin[b] & ~SPHERE_BIT], x0, y0, x1, y1, pixels);
+			continue;
+		}
+		const Triangle& triangle = triangles[bin[b]];
+		const int startX = std::max(triangle.minX, x0) / BLOCK * BLOCK, endX = std::min(triangle.maxX, x1 - 1);
+		const int startY = std::max(triangle.minY, y0) / BLOCK * BLOCK, endY = std::min(triangle.maxY, y1 - 1);
+
+		__m128 A[3], topLeft[3];
+		for (int i = 0; i < 3; i++) {
+			A[i] = _mm_set1_ps(triangle.edgeA[i]);
+			topLeft[i] = _mm_castsi128_ps(_mm_set1_epi32((int)triangle.topLeft[i]));
+		}
+		const __m128 depthA = _mm_set1_ps(triangle.depthA);
+		const __m128 minX = _mm_set1_ps((float)triangle.minX), maxX = _mm_set1_ps((float)triangle.maxX + 1.0f);
+
+		for (int by = startY; by <= endY; by += BLOCK) {
+			for (int bx = startX; bx <= endX; bx += BLOCK) {
+				// Hierarchical depth: the whole block is already nearer than any part of the triangle
+				float& farthest = blockDepth[(size_t)(by / BLOCK) * blocksPerRow + bx / BLOCK];
+				if (triangle.minDepth >= farthest)
+					continue;
+
+				// Block entirely outside one edge, tested at the corner where that edge function is largest
+				bool outside = false;
+				for (int i = 0; i < 3 && !outside; i++) {
+					const float cx = bx + (triangle.edgeA[i] > 0.0f ? BLOCK - 0.5f : 0.5f);
+					const float cy = by + (triangle.edgeB[i] > 0.0f ? BLOCK - 0.5f : 0.5f);
+					outside = triangle.edgeA[i] * cx + triangle.edgeB[i] * cy + triangle.edgeC[i] < 0.0f;
+				}
+				if (outside)
+					continue;
+
+				bool wrote = false;
+				const int rowEnd = std::min(by + BLOCK - 1, endY);
+				for (int y = std::max(by, triangle.minY); y <= rowEnd; y++) {
+					const float py = y + 0.5f;
+					for (int x = bx; x < bx + BLOCK; x += 4) {
+						// Four pixel centres at once against all three edges
+						const __m128 px = _mm_add_ps(_mm_set1_ps((float)x), lanes);
+						__m128 e[3];
+						__m128 mask = _mm_and_ps(_mm_cmpge_ps(px, minX), _mm_cmplt_ps(px, maxX));
+						for (int i = 0; i < 3; i++) {
+							e[i] = _mm_add_ps(_mm_mul_ps(A[i], px), _mm_set1_ps(triangle.edgeB[i] * py + triangle.edgeC[i]));
+							const __m128 inside = _mm_or_ps(_mm_cmpgt_ps(e[i], zero), _mm_and_ps(_mm_cmpeq_ps(e[i], zero), topLeft[i]));
+							mask = _mm_and_ps(mask, inside);
+						}
+						if (!_mm_movemask_ps(mask))
+							continue;
+
+						// Depth test and write, nearer wins like GL_LESS
+						float* target = &depth[(size_t)y * stride + x];
+						const __m128 z = _mm_add_ps(_mm_mul_ps(depthA, px), _mm_set1_ps(triangle.depthB * py + triangle.depthC));
+						const __m128 stored = _mm_loadu_ps(target);
+						mask = _mm_and_ps(mask, _mm_cmplt_ps(z, stored));
+						const int bits = _mm_movemask_ps(mask);
+						if (!bits)
+							continue;
+						_mm_storeu_ps(target, _mm_or_ps(_mm_and_ps(mask, z), _mm_andnot_ps(mask, stored)));
+
+						float weights[3][4];
+						for (int i = 0; i < 3; i++)
+							_mm_storeu_ps(weights[i], e[i]);
+						uint32_t* pixel = &colour[(size_t)y * stride + x];
+						for (int lane = 0; lane < 4; lane++) {
+							if (bits & (1 << lane)) {
+								pixel[lane] = shade(triangle, weights[0][lane], weights[1][lane], weights[2][lane]);
+								pixels++;
+							}
+						}
+						wrote = true;
+					}
+				}
+
+				// Keep the block's farthest depth exact, it only ever moves nearer
+				if (wrote)
+					farthest = blockFarthest(bx, by);
+			}
+		}
+	}
+	tilePixels[tile] += pixels;
+}
+
+void SoftwareRasterizer::rasterSphere(const Sphere& sphere, int x0, int y0, int x1, int y1, uint64_t& pixels)
+{
+	const int blocksPerRow = stride / BLOCK;
+	const int startX = std::max(sphere.minX, x0) / BLOCK * BLOCK, endX = std::min(sphere.maxX, x1 - 1);
+	const int startY = std::max(sphere.minY, y0) / BLOCK * BLOCK, endY = std::min(sphere.maxY, y1 - 1);
+	const float radius2 = sphere.radius * sphere.radius;
+
+	for (int by = startY; by <= endY; by += BLOCK) {
+		for (int bx = startX; bx <= endX; bx += BLOCK) {
+			float& farthest = blockDepth[(size_t)(by / BLOCK) * blocksPerRow + bx / BLOCK];
+			if (sphere.minDepth >= farthest)
+				continue;
+
+			bool wrote = false;
+			const int rowEnd = std::min(by + BLOCK - 1, endY), columnEnd = std::min(bx + BLOCK - 1, endX);
+			for (int y = std::max(by, sphere.minY); y <= rowEnd; y++) {
+				for (int x = std::max(bx, sphere.minX); x <= columnEnd; x++) {
+					// Ray from the eye through the pixel centre against the exact sphere, as the IMPOSTOR fragment stage does
+					const glm::vec3 ray = glm::normalize(rayCorner + rayStepX * (float)x + rayStepY * (float)y);
+					const float along = glm::dot(ray, sphere.toCentre);
+					const float miss = sphere.distance2 - along * along;
+					if (miss > radius2)
+						continue;
+					const glm::vec3 fragPos = eye + ray * (along - std::sqrt(radius2 - miss));
+
+					// Depth of the hit, nearer wins like GL_LESS
+					const glm::vec4 clip = viewProjection * glm::vec4(fragPos, 1.0f);
+					const float z = clip.z / clip.w * 0.5f + 0.5f;
+					float& stored = depth[(size_t)y * stride + x];
+					if (!(z < stored))
+						continue;
+					stored = z;
+					colour[(size_t)y * stride + x] = sphere.lit ? light(fragPos, (fragPos - sphere.centre) / sphere.radius, sphere.colour, sphere.specular) : packColour(sphere.colour);
+					pixels++;
+					wrote = true;
+				}
+			}
+			if (wrote)
+				farthest = blockFarthest(bx, by);
+		}
+	}
+}
+
+float SoftwareRasterizer::blockFarthest(int bx, int by) const
+{
+	__m128 blockFar = _mm_setzero_ps();
+	for (int y = by; y < by + BLOCK; y++) {
+		const float* row = &depth[(size_t)y * stride + bx];
+		blockFar = _mm_max_ps(blockFar, _mm_max_ps(_mm_loadu_ps(row), _mm_loadu_ps(row + 4)));
+	}
+	float values[4];
+	_mm_storeu_ps(values, blockFar);
+	return std::max(std::max(values[0], values[1]), std::max(values[2], values[3]));
+}
+
+uint32_t SoftwareRasterizer::shade(const Triangle& triangle, float b0, float b1, float b2) const
+{
+	if (!triangle.lit)
+		return packColour(triangle.colour);
+
+	// Perspective-correct position and normal
+	const float w = 1.0f / (b0 * triangle.invW[0] + b1 * triangle.invW[1] + b2 * triangle.invW[2]);
+	const glm::vec3 fragPos = (triangle.world[0] * b0 + triangle.world[1] * b1 + triangle.world[2] * b2) * w;
+	const glm::vec3 norm = glm::normalize(triangle.normal[0] * b0 + triangle.normal[1] * b1 + triangle.normal[2] * b2);
+	return light(fragPos, norm, triangle.colour, triangle.specular);
+}
+
+uint32_t SoftwareRasterizer::light(glm::vec3 fragPos, glm::vec3 norm, glm::vec3 objectColour, bool specular) const
+{
+	// Ambient + Diffuse
+	const glm::vec3 lightDir = glm::normalize(lightPos - fragPos);
+	const float diff = std::max(glm::dot(norm, lightDir), 0.0f);
+	glm::vec3 lighting = AMBIENT_STRENGTH * lightColour + diff * lightColour;
+
+	// Specular
+	if (specular) {
+		const glm::vec3 viewDir = glm::normalize(viewPos - fragPos);
+		const glm::vec3 reflectDir = glm::reflect(-lightDir, norm);
+		const float spec = std::pow(std::max(glm::dot(viewDir, reflectDir), 0.0f), SHININESS);
+		lighting += SPECULAR_STRENGTH * spec * lightColour;
+	}
+	return packColour(lighting * objectColour);
+}
+
+void SoftwareRasterizer::ReadPixels(std::vector<unsigned char>& rgba)
+{
+	Flush();
+	rgba.resize((size_t)width * height * 4);
+	for (int y = 0; y < height; y++)
+		std::copy((const unsigned char*)&colour[(size_t)y * stride], (const unsigned char*)&colour[(size_t)y * stride + width], &rgba[(size_t)y * width * 4]);
+}
+
+void SoftwareRasterizer::ResetStats()
+{
+	stats.trianglesSubmitted = stats.trianglesRasterized = stats.pixelsShaded = 0;
+	stats.setupSeconds = stats.rasterSeconds = 0.0;
+}
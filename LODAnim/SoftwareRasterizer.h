@@ -0,0 +1,126 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Software Rasterizer, tile-based multithreaded triangle rasterizer for hosts without a GPU
+
+// Std. Includes
+#include <vector>
+#include <cstdint>
+
+// GL Includes
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+// custom Includes
+#include "Vertex.h"
+#include "UniformRing.h"
+#include "ThreadPool.h"
+
+// Work done since the last ResetStats
+struct RasterStats {
+	uint64_t trianglesSubmitted;   // Every triangle drawn, before culling and clipping
+	uint64_t trianglesRasterized;  // Front facing and on screen, binned to at least one tile
+	uint64_t pixelsShaded;         // Passed the depth test
+	double setupSeconds;           // Vertex transform, clipping and binning
+	double rasterSeconds;          // Tile work, wall time across all workers
+};
+
+// Draws the same Vertex / index data as the GL path with the uber shader's Phong model (LIT, SPECULAR).
+// Triangles are binned into 64x64 tiles as they're drawn; Flush hands each tile to a worker, which tests
+// 4 pixels at a time against the edge functions with SSE and skips 8x8 blocks the hierarchical depth
+// buffer shows are already nearer. Spheres are ray-cast per pixel in the same tiles, like the IMPOSTOR variant.
+// Rows run bottom to top, like glReadPixels
+class SoftwareRasterizer
+{
+public:
+	// Constructor, pool runs the vertex transform and the tiles
+	SoftwareRasterizer(int width, int height, ThreadPool& pool);
+
+	// Camera and light of the frame, everything is cleared to clearColour and the far plane
+	void BeginFrame(const FrameUniforms& frame, glm::vec4 clearColour);
+
+	// Queue count copies of a mesh, one per object. Normal matrices must be filled in. Unlit draws flat colour
+	void Draw(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices, const ObjectUniforms* objects, size_t count, bool lit, bool specular);
+
+	// Queue count exact spheres, one per object, centred on the model's origin with radius scaled by the model like
+	// the IMPOSTOR variant's quad. Each pixel casts a ray, so a sphere costs its screen area rather than triangles
+	void DrawSpheres(const ObjectUniforms* objects, size_t count, float radius, bool lit, bool specular);
+
+	// Rasterize everything queued, also done when the queue fills up
+	void Flush();
+
+	// RGBA8 pixels of the frame so far, width * height, bottom row first
+	void ReadPixels(std::vector<unsigned char>& rgba);
+
+	int Width() const { return width; }
+	int Height() const { return height; }
+
+	const RasterStats& Stats() const { return stats; }
+	void ResetStats();
+
+private:
+	// A vertex after the model and view-projection transforms
+	struct ClipVertex {
+		glm::vec4 clip;
+		glm::vec3 world;
+		glm::vec3 normal;
+	};
+
+	// A triangle ready to rasterize. Edge functions are scaled by 1/area so at a pixel centre they are
+	// the barycentric weights of the corner opposite each edge; depth and 1/w are planes in screen space
+	struct Triangle {
+		float edgeA[3], edgeB[3], edgeC[3];
+		uint32_t topLeft[3];          // All ones when pixels exactly on the edge belong to this triangle
+		float depthA, depthB, depthC;
+		float minDepth;
+		float invW[3];
+		glm::vec3 world[3];           // Pre-divided by w, for perspective-correct interpolation
+		glm::vec3 normal[3];
+		glm::vec3 colour;
+		int minX, minY, maxX, maxY;   // Pixel bounds, inclusive
+		bool lit, specular;
+	};
+
+	// A sphere ready to ray-cast, minDepth is the depth of its nearest point
+	struct Sphere {
+		glm::vec3 centre;
+		float radius;
+		glm::vec3 toCentre;           // From the eye
+		float distance2;              // Squared length of toCentre
+		float minDepth;
+		glm::vec3 colour;
+		int minX, minY, maxX, maxY;   // Pixel bounds, inclusive
+		bool lit, specular;
+	};
+
+	void setupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, const glm::vec3& colour, bool lit, bool specular);
+	void rasterTile(size_t tile);
+	void rasterSphere(const Sphere& sphere, int x0, int y0, int x1, int y1, uint64_t& pixels);
+	float blockFarthest(int bx, int by) const;
+	uint32_t shade(const Triangle& triangle, float b0, float b1, float b2) const;
+	uint32_t light(glm::vec3 fragPos, glm::vec3 norm, glm::vec3 objectColour, bool specular) const;
+
+	/*  Target data  */
+	int width, height;
+	int stride, rows;              // Padded to whole 8x8 blocks
+	int tilesX, tilesY;
+	std::vector<uint32_t> colour;
+	std::vector<float> depth;
+	std::vector<float> blockDepth; // Farthest depth in each 8x8 block
+	uint32_t clearValue;
+
+	/*  Frame data  */
+	glm::mat4 viewProjection;
+	glm::vec3 lightPos, lightColour, viewPos;
+	glm::vec3 eye;                               // From the view matrix, as the uber shader finds it
+	glm::vec3 rayCorner, rayStepX, rayStepY;     // World ray through pixel (x, y) is rayCorner + x * rayStepX + y * rayStepY
+	std::vector<ClipVertex> clipVertices;
+	std::vector<Triangle> triangles;
+	std::vector<Sphere> spheres;
+	std::vector<std::vector<uint32_t> > bins;   // Triangle indices per tile, in draw order, spheres' tagged with SPHERE_BIT
+	std::vector<char> cleared;                   // Tile cleared this frame
+	std::vector<uint64_t> tilePixels;
+
+	ThreadPool& pool;
+	RasterStats stats;
+};
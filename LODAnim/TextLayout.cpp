@@ -0,0 +1,38 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Text Layout, glyph quads for a line of text, kept apart from the GL calls that draw them
+
+// custom Includes
+#include "TextLayout.h"
+
+
+void LayoutText(const std::map<GLchar, Character>& characters, const std::string& text, GLfloat x, GLfloat y, GLfloat scale, std::vector<GlyphQuad>& quads)
+{
+	// Iterate through all characters
+	for (std::string::const_iterator c = text.begin(); c != text.end(); c++)
+	{
+		std::map<GLchar, Character>::const_iterator found = characters.find(*c);
+		if (found == characters.end())
+			continue;
+		const Character& ch = found->second;
+
+		GLfloat xpos = x + ch.Bearing.x * scale;
+		GLfloat ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
+
+		GLfloat w = ch.Size.x * scale;
+		GLfloat h = ch.Size.y * scale;
+		GlyphQuad quad = { ch.TextureID, {
+			{ xpos,     ypos + h,   0.0, 0.0 },
+			{ xpos,     ypos,       0.0, 1.0 },
+			{ xpos + w, ypos,       1.0, 1.0 },
+
+			{ xpos,     ypos + h,   0.0, 0.0 },
+			{ xpos + w, ypos,       1.0, 1.0 },
+			{ xpos + w, ypos + h,   1.0, 0.0 }
+		} };
+		quads.push_back(quad);
+
+		// Now advance cursors for next glyph (note that advance is number of 1/64 pixels)
+		x += (ch.Advance >> 6) * scale; // Bitshift by 6 to get value in pixels (2^6 = 64)
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Text Layout, glyph quads for a line of text, kept apart from the GL calls that draw them
+
+// Std. Includes
+#include <string>
+#include <vector>
+#include <map>
+
+// GL Includes
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+// Character struct for Text Rendering
+struct Character {
+	GLuint TextureID;   // ID handle of the glyph texture
+	glm::ivec2 Size;    // Size of glyph
+	glm::ivec2 Bearing;  // Offset from baseline to left/top of glyph
+	GLuint Advance;    // Horizontal offset to advance to next glyph
+};
+
+// One glyph's textured quad, two triangles of position xy and texture uv
+struct GlyphQuad {
+	GLuint TextureID;
+	GLfloat vertices[6][4];
+};
+
+// Quads for text starting at x, y on the baseline, appended to quads. Characters without a glyph are skipped
+void LayoutText(const std::map<GLchar, Character>& characters, const std::string& text, GLfloat x, GLfloat y, GLfloat scale, std::vector<GlyphQuad>& quads);
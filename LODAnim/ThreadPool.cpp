@@ -0,0 +1,99 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Thread Pool, fixed worker threads for parallel loops and background jobs
+
+// Std. Includes
+#include <algorithm>
+
+// custom Includes
+#include "ThreadPool.h"
+#include "Profiler.h"
+
+
+ThreadPool::ThreadPool(unsigned workers, const std::string& name) :
+	running(0), stopping(false), name(name)
+{
+	if (workers == 0)
+		workers = std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned i = 0; i < workers; i++)
+		threads.push_back(std::thread(&ThreadPool::work, this, i));
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (size_t i = 0; i < threads.size(); i++)
+		threads[i].join();
+}
+
+void ThreadPool::Submit(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		jobs.push_back(std::move(job));
+	}
+	wake.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+	std::unique_lock<std::mutex> guard(lock);
+	idle.wait(guard, [this]() { return jobs.empty() && running == 0; });
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& body)
+{
+	if (count == 0)
+		return;
+
+	// Workers and the caller pull indices until none are left, so uneven items balance themselves
+	struct Loop {
+		std::atomic<size_t> next;
+		size_t exited;
+		std::mutex lock;
+		std::condition_variable finished;
+	} loop;
+	loop.next = 0;
+	loop.exited = 0;
+
+	auto run = [&loop, &body, count]() {
+		for (size_t i = loop.next++; i < count; i = loop.next++)
+			body(i);
+		std::lock_guard<std::mutex> guard(loop.lock);
+		loop.exited++;
+		loop.finished.notify_all();
+	};
+
+	// Only this loop's helpers are waited for, other jobs may still be queued
+	const size_t helpers = std::min(count - 1, threads.size());
+	for (size_t i = 0; i < helpers; i++)
+		Submit(run);
+	run();
+
+	std::unique_lock<std::mutex> guard(loop.lock);
+	loop.finished.wait(guard, [&loop, helpers]() { return loop.exited == helpers + 1; });
+}
+
+void ThreadPool::work(unsigned index)
+{
+	Profiler::Shared().NameThread(name + " " + std::to_string(index));
+	std::unique_lock<std::mutex> guard(lock);
+	while (true) {
+		wake.wait(guard, [this]() { return stopping || !jobs.empty(); });
+		if (jobs.empty())
+			return;
+
+		std::function<void()> job = std::move(jobs.front());
+		jobs.pop_front();
+		running++;
+		guard.unlock();
+		job();
+		guard.lock();
+		if (--running == 0 && jobs.empty())
+			idle.notify_all();
+	}
+}
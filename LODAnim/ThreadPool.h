@@ -0,0 +1,46 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Thread Pool, fixed worker threads for parallel loops and background jobs
+
+// Std. Includes
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <string>
+
+class ThreadPool
+{
+public:
+	// Constructor, 0 workers means one per hardware thread. Workers are named in profiler traces
+	ThreadPool(unsigned workers = 0, const std::string& name = "Worker");
+	~ThreadPool();
+
+	// Queue a job for any worker
+	void Submit(std::function<void()> job);
+
+	// Block until every queued job has finished
+	void Wait();
+
+	// Call body(i) for every i below count, spread over the workers and the calling thread. Returns when all are done
+	void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+	unsigned Workers() const { return (unsigned)threads.size(); }
+
+private:
+	void work(unsigned index);
+
+	/*  Pool data  */
+	std::vector<std::thread> threads;
+	std::deque<std::function<void()> > jobs;
+	std::mutex lock;
+	std::condition_variable wake;    // A job was queued, or the pool is stopping
+	std::condition_variable idle;    // The last running job finished
+	size_t running;
+	bool stopping;
+	std::string name;
+};
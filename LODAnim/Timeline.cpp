@@ -0,0 +1,169 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Timeline, scenario events loaded from a file and replayed in time order
+
+// Std. Includes
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+// custom Includes
+#include "Timeline.h"
+
+
+Timeline::Timeline() :
+	cursor(0), cameraCursor(0), end(-1.0)
+{
+}
+
+bool Timeline::Load(const std::string& path, const std::vector<std::string>& sets)
+{
+	std::ifstream file(path.c_str());
+	if (!file) {
+		std::cout << "ERROR::TIMELINE:: Could not read " << path << std::endl;
+		return false;
+	}
+
+	events.clear();
+	std::string line;
+	int number = 0;
+	while (std::getline(file, line)) {
+		number++;
+
+		// Everything after # is a comment
+		size_t comment = line.find('#');
+		if (comment != std::string::npos)
+			line.erase(comment);
+		if (line.find_first_not_of(" \t\r") == std::string::npos)
+			continue;
+
+		TimelineEvent event;
+		if (!parse(line, number, sets, event)) {
+			std::cout << "ERROR::TIMELINE:: " << path << ":" << number << ": Could not understand \"" << line << "\"" << std::endl;
+			return false;
+		}
+		events.push_back(event);
+	}
+
+	// Sorted once here, so playback is a cursor walking forward
+	std::stable_sort(events.begin(), events.end(), [](const TimelineEvent& a, const TimelineEvent& b) { return a.time < b.time; });
+
+	cameras.clear();
+	end = -1.0;
+	for (size_t i = 0; i < events.size(); i++) {
+		if (events[i].command == TIMELINE_CAMERA)
+			cameras.push_back(i);
+		if (events[i].command == TIMELINE_END && end < 0.0)
+			end = events[i].time;
+	}
+	Rewind();
+	return true;
+}
+
+void Timeline::Rewind()
+{
+	cursor = 0;
+	cameraCursor = 0;
+}
+
+void Timeline::Advance(double time, const std::function<void(const TimelineEvent&)>& apply)
+{
+	while (cursor < events.size() && events[cursor].time <= time) {
+		if (events[cursor].command == TIMELINE_CAMERA)
+			cameraCursor++;
+		apply(events[cursor]);
+		cursor++;
+	}
+}
+
+bool Timeline::CameraAt(double time, glm::vec3& position, glm::vec3& target) const
+{
+	// Between the last keyframe reached and a linear one still ahead
+	if (cameraCursor == 0 || cameraCursor >= cameras.size())
+		return false;
+	const TimelineEvent& from = events[cameras[cameraCursor - 1]];
+	const TimelineEvent& to = events[cameras[cameraCursor]];
+	if (!to.linear || to.time <= from.time)
+		return false;
+
+	float t = (float)((time - from.time) / (to.time - from.time));
+	t = std::min(std::max(t, 0.0f), 1.0f);
+	position = glm::mix(from.position, to.position, t);
+	target = glm::mix(from.target, to.target, t);
+	return true;
+}
+
+int Timeline::LargestField() const
+{
+	int largest = 0;
+	for (size_t i = 0; i < events.size(); i++)
+		if (events[i].command == TIMELINE_FIELD)
+			largest = std::max(largest, events[i].value);
+	return largest;
+}
+
+// <time> <command> [arguments]
+bool Timeline::parse(const std::string& line, int number, const std::vector<std::string>& sets, TimelineEvent& event)
+{
+	std::istringstream in(line);
+	std::string command;
+	if (!(in >> event.time >> command))
+		return false;
+
+	event.value = 0;
+	event.seed = 0;
+	event.position = event.target = glm::vec3(0.0f);
+	event.linear = false;
+	event.line = number;
+
+	if (command == "show" || command == "hide") {
+		event.command = command == "show" ? TIMELINE_SHOW : TIMELINE_HIDE;
+		if (!(in >> event.name) || std::find(sets.begin(), sets.end(), event.name) == sets.end())
+			return false;
+	}
+	else if (command == "mode") {
+		event.command = TIMELINE_MODE;
+		if (!(in >> event.value) || event.value < 0 || event.value > 7)
+			return false;
+	}
+	else if (command == "palette") {
+		event.command = TIMELINE_PALETTE;
+		if (!(in >> event.name) || (event.name != "white" && event.name != "levels"))
+			return false;
+	}
+	else if (command == "camera") {
+		// camera px py pz tx ty tz [cut|linear]
+		event.command = TIMELINE_CAMERA;
+		if (!(in >> event.position.x >> event.position.y >> event.position.z >> event.target.x >> event.target.y >> event.target.z))
+			return false;
+		std::string move = "cut";
+		in >> move;
+		if (move != "cut" && move != "linear")
+			return false;
+		event.linear = move == "linear";
+	}
+	else if (command == "field") {
+		// field count [seed [static]]
+		event.command = TIMELINE_FIELD;
+		if (!(in >> event.value) || event.value < 0)
+			return false;
+		if (in >> event.seed) {
+			std::string kind;
+			if (in >> kind && kind != "static")
+				return false;
+			event.name = kind;
+		}
+	}
+	else if (command == "end") {
+		event.command = TIMELINE_END;
+	}
+	else {
+		return false;
+	}
+
+	// Nothing may follow the arguments
+	std::string rest;
+	in.clear();
+	return !(in >> rest);
+}
@@ -0,0 +1,71 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Timeline, scenario events loaded from a file and replayed in time order
+
+// Std. Includes
+#include <string>
+#include <vector>
+#include <functional>
+
+// GL Includes
+#include <glm/glm.hpp>
+
+// What an event does when the timeline reaches it
+enum TimelineCommand {
+	TIMELINE_SHOW,       // Start drawing a scene set
+	TIMELINE_HIDE,       // Stop drawing a scene set
+	TIMELINE_MODE,       // Switch LOD mode
+	TIMELINE_PALETTE,    // Body colours: white, or one per LOD level
+	TIMELINE_CAMERA,     // Camera keyframe, a cut or the end of a linear move from the previous keyframe
+	TIMELINE_FIELD,      // Generate a field of orbiting or static bodies
+	TIMELINE_END         // Benchmarks stop here
+};
+
+struct TimelineEvent {
+	double time;
+	TimelineCommand command;
+	std::string name;        // Scene set or palette, "static" for a field that doesn't orbit
+	int value;               // Mode, or field body count
+	unsigned seed;           // Field layout
+	glm::vec3 position;      // Camera position and target
+	glm::vec3 target;
+	bool linear;             // Camera moves here from the previous keyframe instead of cutting
+	int line;                // Line in the file, for errors
+};
+
+class Timeline
+{
+public:
+	Timeline();
+
+	// Read a timeline file, sets lists the scene set names show / hide accept. False and an error on bad input
+	bool Load(const std::string& path, const std::vector<std::string>& sets);
+
+	// Back to before the first event
+	void Rewind();
+
+	// Run every event up to and including time, in order. Only the events passed are visited
+	void Advance(double time, const std::function<void(const TimelineEvent&)>& apply);
+
+	// Camera part way along a linear move at time, false when no move is in progress
+	bool CameraAt(double time, glm::vec3& position, glm::vec3& target) const;
+
+	// Time of the end event, negative when the timeline has none
+	double End() const { return end; }
+
+	// Largest field any event generates, so buffers can be sized before loading
+	int LargestField() const;
+
+	const std::vector<TimelineEvent>& Events() const { return events; }
+
+private:
+	bool parse(const std::string& line, int number, const std::vector<std::string>& sets, TimelineEvent& event);
+
+	/*  Timeline data  */
+	std::vector<TimelineEvent> events;   // Sorted by time, file order within a time
+	std::vector<size_t> cameras;         // Indices of the camera events
+	size_t cursor;                       // Next event to run
+	size_t cameraCursor;                 // Next camera keyframe not yet reached
+	double end;
+};
@@ -0,0 +1,212 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Uniform Ring, per-frame std140 uniform data in one mapped buffer
+
+// Std. Includes
+#include <iostream>
+#include <cstring>
+
+// custom Includes
+#include "UniformRing.h"
+#include "FrameStats.h"
+
+// Enough for a few hundred objects a frame, raised by scenes that draw more
+static GLsizeiptr sharedSegmentSize = 1 << 17;
+
+
+UniformRing::UniformRing(GLsizeiptr segmentSize, int framesInFlight) :
+	UBO(0), segmentSize(segmentSize), framesInFlight(framesInFlight), frame(0), head(0),
+	alignment(256), persistent(false), stalls(0), mapped(NULL), flushed(0)
+{
+	if (this->framesInFlight > 4)
+		this->framesInFlight = 4;
+	for (int i = 0; i < 4; i++)
+		fences[i] = 0;
+
+	// Offsets handed to glBindBufferRange must respect the driver's alignment
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	this->segmentSize = aligned(segmentSize);
+
+	// Persistent mapping needs buffer storage (GL 4.4), otherwise orphan each frame
+	persistent = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+	allocate();
+
+	std::cout << "UNIFORM RING: " << this->framesInFlight << " x " << this->segmentSize << " bytes, "
+		<< (persistent ? "persistently mapped" : "orphaned per frame") << std::endl;
+}
+
+void UniformRing::BeginFrame()
+{
+	head = 0;
+	staging.clear();
+	blocks.clear();
+	flushed = 0;
+
+	if (persistent) {
+		// Only blocks if the GPU is still reading a segment from framesInFlight frames ago
+		if (fences[frame]) {
+			GLenum result = glClientWaitSync(fences[frame], 0, 0);
+			if (result == GL_TIMEOUT_EXPIRED) {
+				stalls++;
+				while (glClientWaitSync(fences[frame], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED);
+			}
+			glDeleteSync(fences[frame]);
+			fences[frame] = 0;
+		}
+	}
+	else {
+		// Orphan the whole store once a frame, the driver hands back fresh memory without syncing
+		glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+		glBufferData(GL_UNIFORM_BUFFER, segmentSize * framesInFlight, NULL, GL_STREAM_DRAW);
+	}
+}
+
+void UniformRing::EndFrame()
+{
+	if (persistent)
+		fences[frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	frame = (frame + 1) % framesInFlight;
+}
+
+size_t UniformRing::Stage(const void* data, GLsizeiptr size)
+{
+	// Laid out as they will sit in the segment, so Flush is a single copy
+	StagedBlock block = { (GLintptr)staging.size(), size };
+	staging.resize(aligned(block.offset + size));
+	memcpy(&staging[block.offset], data, size);
+	blocks.push_back(block);
+	FrameStats::Shared().Upload(size);
+	return blocks.size() - 1;
+}
+
+void UniformRing::Flush()
+{
+	if (flushed == blocks.size())
+		return;
+	if (head + (GLsizeiptr)staging.size() > segmentSize)
+		grow(head + (GLsizeiptr)staging.size());
+
+	const GLintptr offset = frame * segmentSize + head;
+	if (persistent) {
+		// Coherent mapping, the copy is visible to the draws that follow without a flush
+		memcpy(mapped + offset, &staging[0], staging.size());
+	}
+	else {
+		glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+		glBufferSubData(GL_UNIFORM_BUFFER, offset, staging.size(), &staging[0]);
+	}
+
+	for (size_t i = flushed; i < blocks.size(); i++)
+		blocks[i].offset += offset;
+	head = aligned(head + (GLsizeiptr)staging.size());
+	staging.clear();
+	flushed = blocks.size();
+}
+
+void UniformRing::Bind(GLuint binding, size_t block)
+{
+	glBindBufferRange(GL_UNIFORM_BUFFER, binding, UBO, blocks[block].offset, blocks[block].size);
+	FrameStats::Shared().BufferBind();
+}
+
+GLintptr UniformRing::Push(const void* data, GLsizeiptr size)
+{
+	if (head + size > segmentSize)
+		grow(head + size);
+	const GLintptr offset = frame * segmentSize + head;
+
+	if (persistent) {
+		// Coherent mapping, the write is visible to the next draw without a flush
+		memcpy(mapped + offset, data, size);
+	}
+	else {
+		glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+		glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+	}
+
+	head = aligned(head + size);
+	FrameStats::Shared().Upload(size);
+	return offset;
+}
+
+void UniformRing::PushAndBind(GLuint binding, const void* data, GLsizeiptr size)
+{
+	GLintptr offset = Push(data, size);
+	glBindBufferRange(GL_UNIFORM_BUFFER, binding, UBO, offset, size);
+	FrameStats::Shared().BufferBind();
+}
+
+UniformRing& UniformRing::Shared()
+{
+	// Triple buffered
+	static UniformRing ring(sharedSegmentSize, 3);
+	return ring;
+}
+
+void UniformRing::UseSegmentSize(GLsizeiptr segmentSize)
+{
+	sharedSegmentSize = segmentSize;
+}
+
+void UniformRing::grow(GLsizeiptr needed)
+{
+	GLsizeiptr size = segmentSize;
+	while (size < needed)
+		size *= 2;
+	std::cout << "UNIFORM RING: A frame needed " << needed << " bytes, segments grown from " << segmentSize << " to " << size << std::endl;
+
+	// No segment of the new buffer is in flight
+	const GLuint previous = UBO;
+	const bool wasMapped = persistent;
+	const GLintptr from = frame * segmentSize;
+	for (int i = 0; i < 4; i++) {
+		if (fences[i])
+			glDeleteSync(fences[i]);
+		fences[i] = 0;
+	}
+	segmentSize = size;
+	allocate();
+
+	// What this frame already put in its segment moves with it, blocks flushed earlier are bound again from the
+	// new buffer. Draws already issued keep reading the old one
+	const GLintptr to = frame * segmentSize;
+	if (head > 0) {
+		glBindBuffer(GL_COPY_READ_BUFFER, previous);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, UBO);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, from, to, head);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+	for (size_t i = 0; i < flushed; i++)
+		blocks[i].offset += to - from;
+
+	// Deleting a buffer the GPU still reads, or one still bound to a block, only frees it once nothing uses it
+	if (wasMapped) {
+		glBindBuffer(GL_COPY_READ_BUFFER, previous);
+		glUnmapBuffer(GL_COPY_READ_BUFFER);
+	}
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glDeleteBuffers(1, &previous);
+}
+
+void UniformRing::allocate()
+{
+	glGenBuffers(1, &UBO);
+	glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+
+	if (persistent) {
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(GL_UNIFORM_BUFFER, segmentSize * framesInFlight, NULL, flags);
+		mapped = (GLbyte*)glMapBufferRange(GL_UNIFORM_BUFFER, 0, segmentSize * framesInFlight, flags);
+		if (!mapped) {
+			std::cout << "ERROR::UNIFORM RING:: Persistent map failed, falling back to orphaning" << std::endl;
+			glDeleteBuffers(1, &UBO);
+			persistent = false;
+			allocate();
+			return;
+		}
+	}
+	else {
+		glBufferData(GL_UNIFORM_BUFFER, segmentSize * framesInFlight, NULL, GL_STREAM_DRAW);
+	}
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
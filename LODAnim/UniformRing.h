@@ -0,0 +1,110 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Uniform Ring, per-frame std140 uniform data in one mapped buffer
+
+// Std. Includes
+#include <vector>
+
+// GL Includes
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+// custom Includes
+#include "NormalMatrix.h"
+
+// Uniform block binding points, shared with the shaders
+const GLuint FRAME_BLOCK_BINDING = 0, OBJECT_BLOCK_BINDING = 1;
+
+// std140 FrameBlock: camera and light, written once per frame
+struct FrameUniforms {
+	glm::mat4 view;
+	glm::mat4 projection;
+	glm::vec4 lightPos;
+	glm::vec4 lightColour;
+	glm::vec4 viewPos;
+};
+
+// std140 ObjectBlock: one per draw
+struct ObjectUniforms {
+	glm::mat4 model;
+	NormalMatrix normalMatrix; // Inverse-transpose of model, the rigid shader variant never reads it
+	glm::vec4 colour;
+};
+
+class UniformRing
+{
+public:
+	// Constructor, one segment of segmentSize bytes for each frame in flight
+	UniformRing(GLsizeiptr segmentSize, int framesInFlight);
+
+	// Wait for the GPU to release this frame's segment and rewind into it
+	void BeginFrame();
+
+	// Fence the segment the frame wrote to
+	void EndFrame();
+
+	// Copy a block into the frame's staging memory, returns its index for Bind. Nothing reaches GL until Flush
+	size_t Stage(const void* data, GLsizeiptr size);
+
+	// Upload every block staged since the last Flush in one copy, growing the segments first if they don't fit
+	void Flush();
+
+	// Bind a flushed block to a uniform block binding point
+	void Bind(GLuint binding, size_t block);
+
+	// Copy one block straight into the current segment, returns its offset in the buffer. For uniforms set
+	// between draws outside a frame, a frame's draws stage theirs
+	GLintptr Push(const void* data, GLsizeiptr size);
+
+	// Push a block and bind it to a uniform block binding point
+	void PushAndBind(GLuint binding, const void* data, GLsizeiptr size);
+
+	// True when the buffer is persistently mapped, false when orphaning
+	bool Persistent() const { return persistent; }
+
+	// Frames that had to wait on the GPU to free their segment
+	int Stalls() const { return stalls; }
+
+	// Bytes per frame, after any growth
+	GLsizeiptr SegmentSize() const { return segmentSize; }
+
+	// Ring used by the whole frame, created on first use (requires a current GL context)
+	static UniformRing& Shared();
+
+	// Choose the Shared() ring's bytes per frame, only before its first use
+	static void UseSegmentSize(GLsizeiptr segmentSize);
+
+private:
+	// A block staged this frame, offset into staging until flushed and into the segment after
+	struct StagedBlock {
+		GLintptr offset;
+		GLsizeiptr size;
+	};
+
+	/*  Ring data  */
+	GLuint UBO;
+	GLsizeiptr segmentSize;
+	int framesInFlight, frame;
+	GLintptr head;                       // Next free byte of the current segment
+	GLint alignment;
+	bool persistent;
+	int stalls;
+	GLbyte* mapped;
+	GLsync fences[4];
+
+	/*  Staging data  */
+	std::vector<GLbyte> staging;
+	std::vector<StagedBlock> blocks;
+	size_t flushed;                      // Blocks already in the segment
+
+	/*  Functions    */
+	void allocate();
+
+	// Replace the buffer with one whose segments hold needed bytes, copying over what the frame already wrote so
+	// flushed blocks stay valid. Blocks already bound keep the old buffer alive
+	void grow(GLsizeiptr needed);
+
+	// Offset rounded up to the driver's binding alignment
+	GLintptr aligned(GLintptr offset) const { return (offset + alignment - 1) / alignment * alignment; }
+};
@@ -0,0 +1,14 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Vertex layout shared by Meshes and the Geometry Arena
+
+// GL Includes
+#include <glm/glm.hpp>
+
+struct Vertex {
+	// Position
+	glm::vec3 Position;
+	// Normal
+	glm::vec3 Normal;
+};
@@ -0,0 +1,265 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Benchmark, a small Google Benchmark style harness: registered functions run over a range of sizes
+
+// Std. Includes
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <regex>
+#include <thread>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+// custom Includes
+#include "Benchmark.h"
+
+// Timed result of one benchmark at one size
+struct BenchmarkRun {
+	std::string name;
+	int64_t iterations;
+	double realNs;      // Per iteration
+	double cpuNs;
+	double itemsPerSecond;
+	std::string error;
+};
+
+
+BenchmarkState::BenchmarkState(int64_t argument, int64_t iterations) :
+	argument(argument), iterations(iterations), remaining(iterations), started(false), running(false),
+	cpuStart(0), realSeconds(0.0), cpuSeconds(0.0), itemsProcessed(0)
+{
+}
+
+bool BenchmarkState::KeepRunning()
+{
+	if (!started) {
+		started = true;
+		start();
+	}
+	if (remaining > 0) {
+		remaining--;
+		return true;
+	}
+	if (running)
+		stop();
+	return false;
+}
+
+void BenchmarkState::PauseTiming()
+{
+	if (running)
+		stop();
+}
+
+void BenchmarkState::ResumeTiming()
+{
+	if (!running)
+		start();
+}
+
+void BenchmarkState::start()
+{
+	running = true;
+	cpuStart = std::clock();
+	realStart = std::chrono::steady_clock::now();
+}
+
+void BenchmarkState::stop()
+{
+	realSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - realStart).count();
+	cpuSeconds += (double)(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+	running = false;
+}
+
+Benchmark::Benchmark(const std::string& name, BenchmarkFunction function) :
+	name(name), function(function), multiplier(8)
+{
+	Registered().push_back(this);
+}
+
+Benchmark* Benchmark::Range(int64_t start, int64_t limit)
+{
+	for (int64_t argument = start; argument < limit; argument *= multiplier)
+		arguments.push_back(argument);
+	arguments.push_back(limit);
+	return this;
+}
+
+Benchmark* Benchmark::DenseRange(int64_t start, int64_t limit)
+{
+	for (int64_t argument = start; argument <= limit; argument++)
+		arguments.push_back(argument);
+	return this;
+}
+
+std::vector<Benchmark*>& Benchmark::Registered()
+{
+	static std::vector<Benchmark*> benchmarks;
+	return benchmarks;
+}
+
+// Grow the iteration count until one run lasts minTime, the same way Google Benchmark settles on a count
+static BenchmarkRun runBenchmark(const Benchmark& benchmark, const std::string& name, int64_t argument, double minTime)
+{
+	BenchmarkRun run;
+	run.name = name;
+
+	int64_t iterations = 1;
+	while (true) {
+		BenchmarkState state(argument, iterations);
+		benchmark.Function()(state);
+
+		const bool done = state.RealSeconds() >= minTime || iterations >= 1000000000 || !state.Error().empty();
+		if (done) {
+			run.iterations = iterations;
+			run.realNs = state.RealSeconds() * 1e9 / iterations;
+			run.cpuNs = state.CpuSeconds() * 1e9 / iterations;
+			run.itemsPerSecond = state.RealSeconds() > 0.0 ? state.ItemsProcessed() / state.RealSeconds() : 0.0;
+			run.error = state.Error();
+			return run;
+		}
+
+		// Aim a little past minTime, at most ten times the previous count
+		double multiple = state.RealSeconds() > 0.0 ? 1.4 * minTime / state.RealSeconds() : 10.0;
+		multiple = std::min(std::max(multiple, 2.0), 10.0);
+		iterations = (int64_t)(iterations * multiple);
+	}
+}
+
+static void writeConsole(std::ostream& out, const std::vector<BenchmarkRun>& runs, bool header)
+{
+	if (header) {
+		out << std::left << std::setw(40) << "Benchmark" << std::right << std::setw(16) << "Time" << std::setw(16) << "CPU"
+			<< std::setw(14) << "Iterations" << "  items/s" << std::endl;
+		out << std::string(100, '-') << std::endl;
+	}
+	const BenchmarkRun& run = runs.back();
+	out << std::left << std::setw(40) << run.name << std::right;
+	if (!run.error.empty()) {
+		out << "  ERROR: " << run.error << std::endl;
+		return;
+	}
+	out << std::fixed << std::setprecision(1) << std::setw(13) << run.realNs << " ns" << std::setw(13) << run.cpuNs << " ns"
+		<< std::setw(14) << run.iterations;
+	if (run.itemsPerSecond > 0.0)
+		out << "  " << std::setprecision(3) << run.itemsPerSecond / 1e6 << "M/s";
+	out << std::endl;
+}
+
+// Google Benchmark's JSON layout, so its tools and compare_benchmarks.py read either
+static void writeJson(std::ostream& out, const std::vector<BenchmarkRun>& runs, const char* executable)
+{
+	std::time_t now = std::time(nullptr);
+	char date[64];
+	std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+	out << "{\n  \"context\": {\n";
+	out << "    \"date\": \"" << date << "\",\n";
+	out << "    \"executable\": \"" << std::regex_replace(executable, std::regex("\\\\"), "/") << "\",\n";
+	out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+	out << "    \"library_build_type\": \"release\"\n";
+#else
+	out << "    \"library_build_type\": \"debug\"\n";
+#endif
+	out << "  },\n  \"benchmarks\": [";
+	out << std::setprecision(6);
+	for (size_t i = 0; i < runs.size(); i++) {
+		const BenchmarkRun& run = runs[i];
+		out << (i ? ",\n" : "\n") << "    {\n";
+		out << "      \"name\": \"" << run.name << "\",\n";
+		out << "      \"run_name\": \"" << run.name << "\",\n";
+		out << "      \"run_type\": \"iteration\",\n";
+		if (!run.error.empty()) {
+			out << "      \"error_occurred\": true,\n";
+			out << "      \"error_message\": \"" << run.error << "\"\n    }";
+			continue;
+		}
+		out << "      \"iterations\": " << run.iterations << ",\n";
+		out << "      \"real_time\": " << run.realNs << ",\n";
+		out << "      \"cpu_time\": " << run.cpuNs << ",\n";
+		out << "      \"time_unit\": \"ns\"";
+		if (run.itemsPerSecond > 0.0)
+			out << ",\n      \"items_per_second\": " << run.itemsPerSecond;
+		out << "\n    }";
+	}
+	out << "\n  ]\n}\n";
+}
+
+// Value of --name=value, NULL if argument is a different flag
+static const char* flagValue(const char* argument, const char* name)
+{
+	size_t length = std::strlen(name);
+	if (std::strncmp(argument, name, length) == 0 && argument[length] == '=')
+		return argument + length + 1;
+	return NULL;
+}
+
+int RunBenchmarks(int argc, char** argv)
+{
+	std::string filter = ".*", format = "console", outPath;
+	double minTime = 0.5;
+	for (int i = 1; i < argc; i++) {
+		const char* value;
+		if ((value = flagValue(argv[i], "--benchmark_filter")))
+			filter = value;
+		else if ((value = flagValue(argv[i], "--benchmark_format")))
+			format = value;
+		else if ((value = flagValue(argv[i], "--benchmark_out")))
+			outPath = value;
+		else if ((value = flagValue(argv[i], "--benchmark_min_time")))
+			minTime = std::atof(value);
+		else {
+			std::cout << "Usage: " << argv[0] << " [--benchmark_filter=regex] [--benchmark_format=console|json]"
+				" [--benchmark_out=path] [--benchmark_min_time=seconds]" << std::endl;
+			return 1;
+		}
+	}
+	if (format != "console" && format != "json") {
+		std::cout << "ERROR::BENCHMARK:: Unknown format " << format << std::endl;
+		return 1;
+	}
+
+	std::regex selected;
+	try {
+		selected = std::regex(filter);
+	}
+	catch (const std::regex_error&) {
+		std::cout << "ERROR::BENCHMARK:: Bad filter " << filter << std::endl;
+		return 1;
+	}
+
+	// Run everything the filter matches, console rows are printed as they finish
+	std::vector<BenchmarkRun> runs;
+	bool failed = false;
+	for (Benchmark* benchmark : Benchmark::Registered()) {
+		std::vector<int64_t> arguments = benchmark->Arguments();
+		if (arguments.empty())
+			arguments.push_back(0);
+		for (int64_t argument : arguments) {
+			// Name/size, like Google Benchmark
+			std::string name = benchmark->Name() + (benchmark->Arguments().empty() ? "" : "/" + std::to_string(argument));
+			if (!std::regex_search(name, selected))
+				continue;
+			runs.push_back(runBenchmark(*benchmark, name, argument, minTime));
+			failed |= !runs.back().error.empty();
+			if (format == "console")
+				writeConsole(std::cout, runs, runs.size() == 1);
+		}
+	}
+
+	if (format == "json")
+		writeJson(std::cout, runs, argv[0]);
+	if (!outPath.empty()) {
+		std::ofstream file(outPath.c_str());
+		if (!file) {
+			std::cout << "ERROR::BENCHMARK:: Could not write " << outPath << std::endl;
+			return 1;
+		}
+		writeJson(file, runs, argv[0]);
+	}
+	return failed ? 1 : 0;
+}
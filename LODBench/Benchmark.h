@@ -0,0 +1,115 @@
+#pragma once
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: Benchmark, a small Google Benchmark style harness: registered functions run over a range of sizes
+
+// Std. Includes
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ctime>
+#include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Keeps a result alive so the optimiser can't drop the work that produced it
+template <class T>
+inline void DoNotOptimize(const T& value)
+{
+#ifdef _MSC_VER
+	static volatile const void* sink;
+	sink = &value;
+	_ReadWriteBarrier();
+#else
+	asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+// Passed to every benchmark function: its size argument and the timed loop
+class BenchmarkState
+{
+public:
+	BenchmarkState(int64_t argument, int64_t iterations);
+
+	// while (state.KeepRunning()) { timed work }, setup before the loop isn't timed
+	bool KeepRunning();
+
+	// Size the benchmark runs at, e.g. object count. Benchmarks take a single argument, so the
+	// index is only there to keep Google Benchmark's state.range(0) spelling
+	int64_t range(int /*index*/ = 0) const { return argument; }
+
+	// Exclude per-iteration setup from the timings
+	void PauseTiming();
+	void ResumeTiming();
+
+	// Items each run processed, reported as items per second
+	void SetItemsProcessed(int64_t items) { itemsProcessed = items; }
+
+	// Fail the run, e.g. a file that couldn't be loaded
+	void SkipWithError(const std::string& message) { error = message; remaining = 0; }
+
+	/*  Results  */
+	int64_t Iterations() const { return iterations; }
+	double RealSeconds() const { return realSeconds; }
+	double CpuSeconds() const { return cpuSeconds; }
+	int64_t ItemsProcessed() const { return itemsProcessed; }
+	const std::string& Error() const { return error; }
+
+private:
+	void start();
+	void stop();
+
+	/*  State data  */
+	int64_t argument;
+	int64_t iterations;
+	int64_t remaining;
+	bool started, running;
+	std::chrono::steady_clock::time_point realStart;
+	std::clock_t cpuStart;
+	double realSeconds, cpuSeconds;
+	int64_t itemsProcessed;
+	std::string error;
+};
+
+typedef void (*BenchmarkFunction)(BenchmarkState&);
+
+// One registered function and the sizes to run it at
+class Benchmark
+{
+public:
+	Benchmark(const std::string& name, BenchmarkFunction function);
+
+	// Sizes from start to limit, multiplying by RangeMultiplier, limit always included
+	Benchmark* Range(int64_t start, int64_t limit);
+	Benchmark* RangeMultiplier(int multiplier) { this->multiplier = multiplier; return this; }
+
+	// Every size from start to limit
+	Benchmark* DenseRange(int64_t start, int64_t limit);
+
+	// One size
+	Benchmark* Arg(int64_t argument) { arguments.push_back(argument); return this; }
+
+	const std::string& Name() const { return name; }
+	BenchmarkFunction Function() const { return function; }
+	const std::vector<int64_t>& Arguments() const { return arguments; }
+
+	// Every registered benchmark, in registration order
+	static std::vector<Benchmark*>& Registered();
+
+private:
+	/*  Benchmark data  */
+	std::string name;
+	BenchmarkFunction function;
+	std::vector<int64_t> arguments;
+	int multiplier;
+};
+
+// Run the benchmarks the command line selects: --benchmark_filter=regex --benchmark_format=console|json
+// --benchmark_out=path (always JSON) --benchmark_min_time=seconds. Returns the process exit code
+int RunBenchmarks(int argc, char** argv);
+
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_(a, b)
+#define BENCHMARK_CONCAT_(a, b) a##b
+#define BENCHMARK(function) \
+	static Benchmark* BENCHMARK_CONCAT(benchmark_, __LINE__) = (new Benchmark(#function, function))
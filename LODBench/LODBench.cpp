@@ -0,0 +1,245 @@
+// Author:  George Othen
+// Date: 19/10/2026
+// Title: LOD Bench, timings of the per-object LOD work from 1 to 1M objects
+//
+// Run from this directory so ../Models resolves, e.g.
+//   LODBench --benchmark_out=current.json
+//   python compare_benchmarks.py baseline.json current.json
+
+// Std. Includes
+#include <vector>
+#include <random>
+#include <string>
+
+// GL Includes
+#include <glm/glm.hpp>
+
+// custom Includes
+#include "Benchmark.h"
+#include "../LODAnim/LevelOfDetail.h"
+#include "../LODAnim/TextLayout.h"
+#include "../LODAnim/Model.h"
+#include "../LODAnim/SoftwareRasterizer.h"
+#include "../LODAnim/NormalMatrix.h"
+#include "../LODAnim/DrawQueue.h"
+#include "../LODAnim/ImageError.h"
+
+using namespace std;
+
+// Largest scale, a million objects
+const int64_t MAX_OBJECTS = 1 << 20;
+
+// Same thresholds and camera as the scene's normal mode
+float Distances[] = { 35.0f, 55.0f, 65.0f, 75.0f, 100.0f };
+const glm::vec3 cameraPosition(0.0f, 32.0f, 11.0f);
+
+// Positions spread over a generated field's extent, the same every run
+static vector<glm::vec3> fieldPositions(int64_t count)
+{
+	mt19937 random(1);
+	auto uniform = [&random](float low, float high) { return low + (high - low) * (float)(random() / 4294967296.0); };
+
+	vector<glm::vec3> positions((size_t)count);
+	for (glm::vec3& position : positions)
+		position = glm::vec3(uniform(-200.0f, 200.0f), uniform(-200.0f, 200.0f), uniform(-4.0f, 4.0f));
+	return positions;
+}
+
+static void BM_EuclideanDistance(BenchmarkState& state)
+{
+	vector<glm::vec3> positions = fieldPositions(state.range(0));
+	while (state.KeepRunning()) {
+		float sum = 0.0f;
+		for (const glm::vec3& position : positions)
+			sum += EuclideanDistance(position, cameraPosition);
+		DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.Iterations() * state.range(0));
+}
+BENCHMARK(BM_EuclideanDistance)->Range(1, MAX_OBJECTS);
+
+static void BM_CheckLevel(BenchmarkState& state)
+{
+	vector<glm::vec3> positions = fieldPositions(state.range(0));
+	while (state.KeepRunning()) {
+		int levels[LOD_LEVELS] = {};
+		for (const glm::vec3& position : positions)
+			levels[CheckLevel(position, cameraPosition, Distances)]++;
+		DoNotOptimize(levels);
+	}
+	state.SetItemsProcessed(state.Iterations() * state.range(0));
+}
+BENCHMARK(BM_CheckLevel)->Range(1, MAX_OBJECTS);
+
+// Orbit position and LOD level of every body, what the field update does each frame
+static void BM_OrbitUpdate(BenchmarkState& state)
+{
+	mt19937 random(1);
+	auto uniform = [&random](float low, float high) { return low + (high - low) * (float)(random() / 4294967296.0); };
+	vector<glm::vec4> orbits((size_t)state.range(0)); // radius, speed, phase, height
+	for (glm::vec4& orbit : orbits) {
+		orbit.x = uniform(8.0f, 200.0f);
+		orbit.y = orbit.x * uniform(0.3f, 0.7f);
+		orbit.z = uniform(0.0f, 6.2832f);
+		orbit.w = uniform(-4.0f, 4.0f);
+	}
+
+	float time = 0.0f;
+	vector<glm::vec3> positions(orbits.size());
+	vector<int> levels(orbits.size());
+	while (state.KeepRunning()) {
+		time += 1.0f / 60.0f;
+		for (size_t i = 0; i < orbits.size(); i++) {
+			positions[i] = OrbitPosition(time + orbits[i].z, orbits[i].x, orbits[i].y, orbits[i].w);
+			levels[i] = CheckLevel(positions[i], cameraPosition, Distances);
+		}
+		DoNotOptimize(positions[0]);
+		DoNotOptimize(levels[0]);
+	}
+	state.SetItemsProcessed(state.Iterations() * state.range(0));
+}
+BENCHMARK(BM_OrbitUpdate)->Range(1, MAX_OBJECTS);
+
+// Model matrix of an orbiting body, translate then spin about Z
+static void BM_TransformR(BenchmarkState& state)
+{
+	vector<glm::vec3> positions = fieldPositions(state.range(0));
+	vector<glm::mat4> models(positions.size());
+	const glm::vec3 rotateZ(0.0f, 0.0f, 1.0f);
+
+	float time = 0.0f;
+	while (state.KeepRunning()) {
+		time += 1.0f / 60.0f;
+		for (size_t i = 0; i < positions.size(); i++)
+			models[i] = Model::BuildTransformR(positions[i], rotateZ, 100.0f, true, time);
+		DoNotOptimize(models[0]);
+	}
+	state.SetItemsProcessed(state.Iterations() * state.range(0));
+}
+BENCHMARK(BM_TransformR)->Range(1, MAX_OBJECTS);
+
+// OBJ parse of each LOD level, the part of loading that doesn't touch the GPU. Items are vertices
+static void BM_LoadModel(BenchmarkState& state)
+{
+	const string path = "../Models/" + to_string(state.range(0)) + ".obj";
+	size_t vertices = 0;
+	while (state.KeepRunning()) {
+		vector<MeshData> meshes;
+		if (!Model::Import(path, meshes)) {
+			state.SkipWithError("Could not load " + path);
+			return;
+		}
+		vertices = meshes.empty() ? 0 : meshes[0].vertices.size();
+		DoNotOptimize(meshes);
+	}
+	state.SetItemsProcessed(state.Iterations() * (int64_t)vertices);
+}
+BENCHMARK(BM_LoadModel)->DenseRange(0, 4);
+
+// One frame of 1024 bodies of each LOD level in front of the camera, at 720p on the software rasterizer. Items are triangles
+static void BM_SoftwareRaster(BenchmarkState& state)
+{
+	const string path = "../Models/" + to_string(state.range(0)) + ".obj";
+	vector<MeshData> meshes;
+	if (!Model::Import(path, meshes) || meshes.empty()) {
+		state.SkipWithError("Could not load " + path);
+		return;
+	}
+
+	// A 32 x 32 grid of lit bodies filling the view
+	vector<ObjectUniforms> objects(1024);
+	vector<glm::mat4> models(objects.size());
+	for (size_t i = 0; i < objects.size(); i++) {
+		models[i] = glm::translate(glm::mat4(), glm::vec3((float)(i % 32) * 2.0f - 31.0f, (float)(i / 32) * 2.0f - 31.0f, 0.0f));
+		objects[i].model = models[i];
+		objects[i].colour = glm::vec4(1.0f);
+	}
+	vector<NormalMatrix> normals(objects.size());
+	ComputeNormalMatrices(&models[0], &normals[0], models.size());
+	for (size_t i = 0; i < objects.size(); i++)
+		objects[i].normalMatrix = normals[i];
+
+	FrameUniforms frame;
+	frame.view = glm::lookAt(glm::vec3(0.0f, 0.0f, 40.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	frame.projection = glm::perspective(glm::radians(50.0f), 1280.0f / 720.0f, 0.1f, 210.0f);
+	frame.lightPos = glm::vec4(0.0f, 0.0f, 30.0f, 1.0f);
+	frame.lightColour = glm::vec4(1.0f, 0.9f, 0.8f, 1.0f);
+	frame.viewPos = glm::vec4(0.0f, 0.0f, 40.0f, 1.0f);
+
+	ThreadPool pool(0, "Raster");
+	SoftwareRasterizer rasterizer(1280, 720, pool);
+	while (state.KeepRunning()) {
+		rasterizer.BeginFrame(frame, glm::vec4(0.25f, 0.25f, 0.35f, 1.0f));
+		rasterizer.Draw(meshes[0].vertices, meshes[0].indices, &objects[0], objects.size(), true, true);
+		rasterizer.Flush();
+	}
+	state.SetItemsProcessed(state.Iterations() * (int64_t)(objects.size() * meshes[0].indices.size() / 3));
+}
+BENCHMARK(BM_SoftwareRaster)->DenseRange(0, 4);
+
+// Radix sort of N draw keys shaped like the scene's: a few passes and programs, the five level meshes, any depth
+static void BM_DrawQueueSort(BenchmarkState& state)
+{
+	vector<glm::vec3> positions = fieldPositions(state.range(0));
+	vector<DrawKey> keys((size_t)state.range(0)), sorted, scratch;
+	for (size_t i = 0; i < keys.size(); i++) {
+		keys[i].key = DrawQueue::Key((unsigned)(i % 3), 1 + (unsigned)(i % 5), (unsigned)(i % 5) * 4096, EuclideanDistance(positions[i], cameraPosition));
+		keys[i].item = (uint32_t)i;
+	}
+	while (state.KeepRunning()) {
+		sorted = keys;
+		DrawQueue::RadixSort(sorted, scratch);
+		DoNotOptimize(sorted.data());
+	}
+	state.SetItemsProcessed(state.Iterations() * state.range(0));
+}
+BENCHMARK(BM_DrawQueueSort)->Range(1, MAX_OBJECTS);
+
+// PSNR, SSIM and max error of an N x N frame against a reference that differs in every seventh byte. Items are pixels
+static void BM_ImageCompare(BenchmarkState& state)
+{
+	const int side = (int)state.range(0);
+	mt19937 random(1);
+	vector<unsigned char> reference((size_t)side * side * 4), image;
+	for (unsigned char& value : reference)
+		value = (unsigned char)random();
+	image = reference;
+	for (size_t i = 0; i < image.size(); i += 7)
+		image[i] = (unsigned char)random();
+
+	ImageComparer comparer;
+	while (state.KeepRunning()) {
+		ImageError error = comparer.Compare(&reference[0], &image[0], side, side);
+		DoNotOptimize(error.ssim);
+	}
+	state.SetItemsProcessed(state.Iterations() * side * side);
+}
+BENCHMARK(BM_ImageCompare)->Range(64, 2048);
+
+// Glyph quads for a line of N characters, with glyph metrics shaped like a 48px Arial
+static void BM_TextLayout(BenchmarkState& state)
+{
+	map<GLchar, Character> characters;
+	for (int c = 32; c < 128; c++) {
+		Character character = { (GLuint)c, glm::ivec2(20 + c % 9, 30 + c % 7), glm::ivec2(2, 28 + c % 5), (GLuint)((24 + c % 11) << 6) };
+		characters[(GLchar)c] = character;
+	}
+	const string alphabet = "(Left | Right Arrows) Normal LOD Mode ";
+	string text((size_t)state.range(0), ' ');
+	for (size_t i = 0; i < text.size(); i++)
+		text[i] = alphabet[i % alphabet.size()];
+
+	vector<GlyphQuad> quads;
+	while (state.KeepRunning()) {
+		quads.clear();
+		LayoutText(characters, text, 5.0f, 5.0f, 0.5f, quads);
+		DoNotOptimize(quads.data());
+	}
+	state.SetItemsProcessed(state.Iterations() * state.range(0));
+}
+BENCHMARK(BM_TextLayout)->Range(1, MAX_OBJECTS);
+
+int main(int argc, char** argv)
+{
+	return RunBenchmarks(argc, argv);
+}
@@ -0,0 +1,63 @@
+# Author:  George Othen
+# Date: 19/10/2026
+# Title: Compare two LODBench (or Google Benchmark) JSON outputs and flag regressions
+#
+# Usage: python compare_benchmarks.py baseline.json current.json [--threshold 10] [--metric real_time|cpu_time]
+# Exits 1 when any benchmark is slower than the baseline by more than threshold percent.
+# Store a baseline with: LODBench --benchmark_out=baseline.json
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    times = {}
+    for run in report.get("benchmarks", []):
+        if run.get("error_occurred") or run.get("run_type", "iteration") != "iteration":
+            continue
+        times[run["name"]] = run
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flag benchmark regressions against a stored baseline")
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0, help="percent slower that counts as a regression")
+    parser.add_argument("--metric", choices=["real_time", "cpu_time"], default="cpu_time")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = 0
+    print("%-40s %14s %14s %9s" % ("Benchmark", "Baseline ns", "Current ns", "Change"))
+    print("-" * 80)
+    for name, run in current.items():
+        if name not in baseline:
+            print("%-40s %14s %14.1f %9s" % (name, "-", run[args.metric], "new"))
+            continue
+        before = baseline[name][args.metric]
+        after = run[args.metric]
+        change = (after - before) / before * 100.0 if before > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print("%-40s %14.1f %14.1f %+8.1f%%%s" % (name, before, after, change, flag))
+    for name in baseline:
+        if name not in current:
+            print("%-40s %14.1f %14s %9s" % (name, baseline[name][args.metric], "-", "missing"))
+
+    if regressions:
+        print("\n%d benchmark(s) more than %.1f%% slower than %s" % (regressions, args.threshold, args.baseline))
+        return 1
+    print("\nNo regressions above %.1f%%" % args.threshold)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,9 +0,0 @@
-// Source: https://learnopengl.com
-// Credit: JOEY DE VRIES
-#version 330 core
-out vec4 color;
-
-void main()
-{
-    color = vec4(1.0f, 0.90f, 0.0f, 1.0f); // Set alle 4 vector values to 1.0f
-}
\ No newline at end of file
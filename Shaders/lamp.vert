@@ -1,13 +0,0 @@
-// Source: https://learnopengl.com
-// Credit: JOEY DE VRIES
-#version 330 core
-layout (location = 0) in vec3 position;
-
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main()
-{
-    gl_Position = projection * view * model * vec4(position, 1.0f);
-} 
\ No newline at end of file
@@ -0,0 +1,320 @@
+// Source: https://learnopengl.com
+// Credit: JOEY DE VRIES
+// Uber shader: every program is a permutation of this file. The application defines
+// the stage (VERTEX_STAGE, GEOMETRY_STAGE, FRAGMENT_STAGE) and any of these features:
+//   LIT                       Ambient + diffuse, flat colour when not defined (sun, fallback)
+//   SPECULAR                  Adds the Phong highlight, only worth it up close
+//   WIREFRAME                 Triangle edges over the surface, adds the geometry stage
+//   INSTANCED                 Per-object data indexed by gl_InstanceID
+//   PACKED_VERTEX             Normals arrive as 10:10:10:2 and are renormalised
+//   RIGID_TRANSFORM           mat3(model) turns normals, no normal matrix read
+//   NORMAL_MATRIX_PER_VERTEX  Reference path, full inverse for every vertex
+//   TEXT                      HUD glyph quads, ignores everything else
+//   IMPOSTOR                  Exact sphere ray-cast on a quad facing the eye, the mesh is a quad of +-radius
+//   IMPOSTOR_BAKE             Albedo and coverage, model-space normal and depth into two targets, for the atlas
+//   OCTAHEDRAL_IMPOSTOR       Same quad, blends the four baked atlas views nearest the eye direction
+#version 330 core
+
+#define MAX_INSTANCES 128
+
+// Octahedral atlas: IMPOSTOR_FRAMES x IMPOSTOR_FRAMES views, each covering +-IMPOSTOR_MARGIN radii
+#define IMPOSTOR_FRAMES 8
+#define IMPOSTOR_MARGIN 1.1f
+
+#ifdef TEXT
+/// TEXT ---------------------------------------------------------------------------------------------------
+#ifdef VERTEX_STAGE
+layout (location = 0) in vec4 vertex; // <vec2 pos, vec2 tex>
+out vec2 TexCoords;
+
+uniform mat4 projection;
+
+void main()
+{
+    gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
+    TexCoords = vertex.zw;
+}
+#endif
+
+#ifdef FRAGMENT_STAGE
+in vec2 TexCoords;
+out vec4 color;
+
+uniform sampler2D text;
+uniform vec3 textColor;
+
+void main()
+{    
+    vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
+    color = vec4(textColor, 1.0) * sampled;
+}
+#endif
+
+#else
+/// OBJECTS ------------------------------------------------------------------------------------------------
+layout (std140) uniform FrameBlock {
+    mat4 view;
+    mat4 projection;
+    vec4 lightPos;
+    vec4 lightColour;
+    vec4 viewPos;
+};
+
+#if defined(OCTAHEDRAL_IMPOSTOR)
+#define OBJECT_VARYINGS vec3 Normal; vec3 FragPos; flat vec4 Colour; flat vec4 Sphere; vec2 FrameUV[4]; flat vec4 FrameWeights; flat mat3 Rotation;
+#elif defined(IMPOSTOR)
+#define OBJECT_VARYINGS vec3 Normal; vec3 FragPos; flat vec4 Colour; flat vec4 Sphere;
+#else
+#define OBJECT_VARYINGS vec3 Normal; vec3 FragPos; flat vec4 Colour;
+#endif
+
+#ifdef VERTEX_STAGE
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 normal;
+
+struct ObjectData {
+    mat4 model;
+    mat3 normalMatrix;
+    vec4 colour;
+};
+
+#ifdef INSTANCED
+layout (std140) uniform ObjectBlock {
+    ObjectData objects[MAX_INSTANCES];
+};
+#define OBJECT objects[gl_InstanceID]
+#else
+layout (std140) uniform ObjectBlock {
+    ObjectData object;
+};
+#define OBJECT object
+#endif
+
+out ObjectVertex { OBJECT_VARYINGS } vs_out;
+
+#ifdef OCTAHEDRAL_IMPOSTOR
+// Unit direction to atlas coordinates in [0, 1], the lower hemisphere folded over the corners
+vec2 octahedralEncode(vec3 n)
+{
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    vec2 p = n.xy;
+    if (n.z < 0.0f)
+        p = (1.0f - abs(p.yx)) * vec2(p.x >= 0.0f ? 1.0f : -1.0f, p.y >= 0.0f ? 1.0f : -1.0f);
+    return p * 0.5f + 0.5f;
+}
+
+vec3 octahedralDecode(vec2 uv)
+{
+    vec2 p = uv * 2.0f - 1.0f;
+    vec3 n = vec3(p, 1.0f - abs(p.x) - abs(p.y));
+    if (n.z < 0.0f)
+        n.xy = (1.0f - abs(n.yx)) * vec2(n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f);
+    return normalize(n);
+}
+
+// Image axes of the view baked from direction, as glm::lookAt builds them
+void bakeAxes(vec3 direction, out vec3 right, out vec3 up)
+{
+    vec3 forward = -direction;
+    vec3 worldUp = abs(direction.y) > 0.99f ? vec3(0.0f, 0.0f, 1.0f) : vec3(0.0f, 1.0f, 0.0f);
+    right = normalize(cross(forward, worldUp));
+    up = cross(right, forward);
+}
+#endif
+
+void main()
+{
+    mat4 model = OBJECT.model;
+#if defined(IMPOSTOR) || defined(OCTAHEDRAL_IMPOSTOR)
+    // Square facing the eye through the body's centre, just wide enough for the silhouette: the cone from
+    // the eye that touches the sphere crosses this plane in a circle of radius r * d / sqrt(d^2 - r^2)
+    float radius = abs(position.x) * length(model[0].xyz);
+    vec3 centre = vec3(view * model[3]);
+    float distance2 = max(dot(centre, centre), radius * radius * 1.01f);
+    float halfSize = radius * sqrt(distance2 / (distance2 - radius * radius));
+    vec3 forward = normalize(-centre);
+    vec3 right = normalize(cross(vec3(0.0f, 1.0f, 0.0f), forward));
+    vec3 up = cross(forward, right);
+    vec3 corner = centre + (sign(position.x) * right + sign(position.y) * up) * halfSize;
+
+    // The view is rigid, its inverse is the transposed rotation
+    gl_Position = projection * vec4(corner, 1.0f);
+    vs_out.FragPos = transpose(mat3(view)) * (corner - view[3].xyz);
+    vs_out.Colour = OBJECT.colour;
+    vs_out.Normal = vec3(0.0f);
+    vs_out.Sphere = vec4(vec3(model[3]), radius);
+
+#ifdef OCTAHEDRAL_IMPOSTOR
+    // The eye direction in the model's frame picks the four nearest baked views, weighted bilinearly
+    mat3 rotation = mat3(model) / length(model[0].xyz);
+    vec3 eye = -transpose(mat3(view)) * view[3].xyz;
+    vec3 toEye = transpose(rotation) * normalize(eye - vs_out.Sphere.xyz);
+    vec2 grid = octahedralEncode(toEye) * float(IMPOSTOR_FRAMES) - 0.5f;
+    vec2 cell = floor(grid), blend = grid - cell;
+    vs_out.FrameWeights = vec4((1.0f - blend.x) * (1.0f - blend.y), blend.x * (1.0f - blend.y), (1.0f - blend.x) * blend.y, blend.x * blend.y);
+
+    // This corner in each view's image, its plane through the centre seen along the view's own direction
+    vec3 local = transpose(rotation) * (vs_out.FragPos - vs_out.Sphere.xyz) / (radius * IMPOSTOR_MARGIN);
+    for (int i = 0; i < 4; i++) {
+        vec2 frame = clamp(cell + vec2(i & 1, i >> 1), 0.0f, float(IMPOSTOR_FRAMES - 1));
+        vec3 frameRight, frameUp;
+        bakeAxes(octahedralDecode((frame + 0.5f) / float(IMPOSTOR_FRAMES)), frameRight, frameUp);
+        vs_out.FrameUV[i] = (frame + 0.5f + 0.5f * vec2(dot(local, frameRight), dot(local, frameUp))) / float(IMPOSTOR_FRAMES);
+    }
+    vs_out.Rotation = rotation;
+#endif
+#else
+    vec4 worldPos = model * vec4(position, 1.0f);
+    gl_Position = projection * view * worldPos;
+    vs_out.FragPos = vec3(worldPos);
+    vs_out.Colour = OBJECT.colour;
+
+#ifdef LIT
+#ifdef PACKED_VERTEX
+    vec3 n = normalize(normal);
+#else
+    vec3 n = normal;
+#endif
+#if defined(RIGID_TRANSFORM)
+    // Rotation, translation and uniform scale only, the model matrix turns normals correctly
+    vs_out.Normal = mat3(model) * n;
+#elif defined(NORMAL_MATRIX_PER_VERTEX)
+    // Reference path for timing, the full inverse for every vertex
+    vs_out.Normal = mat3(transpose(inverse(model))) * n;
+#else
+    // Computed once per object on the CPU
+    vs_out.Normal = OBJECT.normalMatrix * n;
+#endif
+#else
+    vs_out.Normal = vec3(0.0f);
+#endif
+#endif
+}
+#endif
+
+#ifdef GEOMETRY_STAGE
+layout (triangles) in;
+layout (triangle_strip, max_vertices = 3) out;
+
+in ObjectVertex { OBJECT_VARYINGS } gs_in[];
+out WireVertex { OBJECT_VARYINGS noperspective vec3 Barycentric; } gs_out;
+
+// Pass the triangle through, tagging each corner so the fragment stage knows its distance to every edge
+void main()
+{
+    for (int i = 0; i < 3; i++) {
+        gl_Position = gl_in[i].gl_Position;
+        gs_out.Normal = gs_in[i].Normal;
+        gs_out.FragPos = gs_in[i].FragPos;
+        gs_out.Colour = gs_in[i].Colour;
+        gs_out.Barycentric = vec3(i == 0, i == 1, i == 2);
+        EmitVertex();
+    }
+    EndPrimitive();
+}
+#endif
+
+#ifdef FRAGMENT_STAGE
+#ifdef WIREFRAME
+in WireVertex { OBJECT_VARYINGS noperspective vec3 Barycentric; } fs_in;
+#else
+in ObjectVertex { OBJECT_VARYINGS } fs_in;
+#endif
+#ifdef IMPOSTOR_BAKE
+layout (location = 0) out vec4 color;
+layout (location = 1) out vec4 normalDepth;
+#else
+out vec4 color;
+#endif
+
+#ifdef OCTAHEDRAL_IMPOSTOR
+uniform sampler2D impostorAlbedo;
+uniform sampler2D impostorNormalDepth;
+#endif
+
+void main()
+{
+    vec3 albedo = fs_in.Colour.rgb;
+#if defined(IMPOSTOR)
+    // Ray from the eye through this point of the quad against the exact sphere, misses are outside the silhouette
+    vec3 eye = -transpose(mat3(view)) * view[3].xyz;
+    vec3 ray = normalize(fs_in.FragPos - eye);
+    vec3 toCentre = fs_in.Sphere.xyz - eye;
+    float along = dot(ray, toCentre);
+    float miss = dot(toCentre, toCentre) - along * along;
+    float radius2 = fs_in.Sphere.w * fs_in.Sphere.w;
+    if (miss > radius2)
+        discard;
+    vec3 fragPos = eye + ray * (along - sqrt(radius2 - miss));
+    vec3 normal = (fragPos - fs_in.Sphere.xyz) / fs_in.Sphere.w;
+
+    // Depth of the hit rather than the quad, so impostors intersect meshes and each other correctly
+    vec4 clip = projection * view * vec4(fragPos, 1.0f);
+    gl_FragDepth = (clip.z / clip.w) * 0.5f + 0.5f;
+#elif defined(OCTAHEDRAL_IMPOSTOR)
+    // Blend of the nearest baked views. Empty texels are all zero, so dividing by coverage averages only the
+    // views that cover this point
+    vec4 coverage = vec4(0.0f), baked = vec4(0.0f);
+    for (int i = 0; i < 4; i++) {
+        coverage += texture(impostorAlbedo, fs_in.FrameUV[i]) * fs_in.FrameWeights[i];
+        baked += texture(impostorNormalDepth, fs_in.FrameUV[i]) * fs_in.FrameWeights[i];
+    }
+    if (coverage.a < 0.5f)
+        discard;
+    baked /= coverage.a;
+    albedo *= coverage.rgb / coverage.a;
+    vec3 normal = fs_in.Rotation * (baked.xyz * 2.0f - 1.0f);
+
+    // Baked depth runs from IMPOSTOR_MARGIN radii in front of the centre to as far behind it
+    vec3 eye = -transpose(mat3(view)) * view[3].xyz;
+    vec3 fragPos = fs_in.FragPos + normalize(eye - fs_in.Sphere.xyz) * fs_in.Sphere.w * IMPOSTOR_MARGIN * (1.0f - 2.0f * baked.w);
+    vec4 clip = projection * view * vec4(fragPos, 1.0f);
+    gl_FragDepth = (clip.z / clip.w) * 0.5f + 0.5f;
+#else
+    vec3 fragPos = fs_in.FragPos;
+    vec3 normal = fs_in.Normal;
+#endif
+
+#ifdef IMPOSTOR_BAKE
+    // Linear depth of an orthographic view, 0 at the near plane
+    color = vec4(albedo, 1.0f);
+    normalDepth = vec4(normalize(normal) * 0.5f + 0.5f, gl_FragCoord.z);
+    return;
+#endif
+
+#ifdef LIT
+    // Ambient
+    float ambientStrength = 0.2f;
+    vec3 ambient = ambientStrength * lightColour.rgb;
+  	
+    // Diffuse 
+    vec3 norm = normalize(normal);
+    vec3 lightDir = normalize(lightPos.xyz - fragPos);
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * lightColour.rgb;
+    vec3 lighting = ambient + diffuse;
+
+#ifdef SPECULAR
+    // Specular
+    float specularStrength = 0.8f;
+    vec3 viewDir = normalize(viewPos.xyz - fragPos);
+    vec3 reflectDir = reflect(-lightDir, norm);  
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
+    lighting += specularStrength * spec * lightColour.rgb;  
+#endif
+    vec3 result = lighting * albedo;
+#else
+    vec3 result = albedo;
+#endif
+
+#ifdef WIREFRAME
+    // About a pixel wide edge wherever a barycentric coordinate nears zero, faces fade back
+    vec3 width = fwidth(fs_in.Barycentric);
+    vec3 edges = smoothstep(vec3(0.0f), width * 1.5f, fs_in.Barycentric);
+    float edge = 1.0f - min(min(edges.x, edges.y), edges.z);
+    result = mix(result * 0.15f, fs_in.Colour.rgb, edge);
+#endif
+    color = vec4(result, 1.0f);
+}
+#endif
+#endif